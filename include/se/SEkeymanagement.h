@@ -135,7 +135,21 @@ void test_activateRtKeyForSigning(void);
 void test_rtKeyCreationSpeed(void);
 void test_baKeyCreationSpeed(void);
 
-/** Number of keys created during key creation test */
-#define KEY_SPEED_CREATE_NUM 2000
+/** Number of key types measured by key creation speed tests */
+#define KEY_SPEED_NUM_TYPES	8
+/** Key class: run time keys */
+#define KEY_CLASS_RT	0
+/** Key class: base keys */
+#define KEY_CLASS_BA	1
+/** Number of first/last keys averaged to compare empty and full storage */
+#define KEY_SPEED_GROUP_SLOTS	100
+/** Percentile of latency compared to key speed thresholds, 100.0f for max */
+#define KEY_SPEED_CHECK_PERCENTILE	99.0f
+/** Rt key creation latency pass/fail threshold, in ms */
+#define KEY_SPEED_RT_CREATE_THRESHOLD	50.0f
+/** Ba key creation latency pass/fail threshold, in ms */
+#define KEY_SPEED_BA_CREATE_THRESHOLD	50.0f
+/** Key deletion latency pass/fail threshold, in ms */
+#define KEY_SPEED_DELETE_THRESHOLD	10.0f
 
 #endif
@@ -51,26 +51,101 @@
 #define SE_PERFORMANCE_TESTS \
 	VTEST_DEFINE_TEST(130201, &test_sigVerifRate, \
 		"Test rate of signature verification")\
+	VTEST_DEFINE_TEST(130202, &test_sigVerifRateDepth, \
+		"Test rate of signature verification vs requests in flight")\
+	VTEST_DEFINE_TEST(130203, &test_sigVerifKnee, \
+		"Find throughput/latency knee of signature verification")\
+	VTEST_DEFINE_TEST(130204, &test_sigVerifRateThreads, \
+		"Test rate of signature verification from several threads")\
+	VTEST_DEFINE_TEST(130205, &test_sigVerifCurves, \
+		"Test rate and latency of signature verification per curve")\
+	VTEST_DEFINE_TEST(130206, &test_sigVerifMsgSize, \
+		"Test rate of signature verification vs message size")\
+	VTEST_DEFINE_TEST(130207, &test_sigVerifPreHash, \
+		"Test rate of signature verification with host pre-hashing")\
+	VTEST_DEFINE_TEST(130208, &test_sigVerifDecomp, \
+		"Test rate and latency of public key decompression")\
+	VTEST_DEFINE_TEST(130209, &test_pubKeyReconRate, \
+		"Test rate and latency of public key reconstruction")\
+	VTEST_DEFINE_TEST(130210, &test_certChainRate, \
+		"Test rate and latency of certificate chain validation")\
 	VTEST_DEFINE_TEST(130301, &test_sigGenRate, \
 		"Test rate of signature generation")\
+	VTEST_DEFINE_TEST(130302, &test_sigGenKnee, \
+		"Find throughput/latency knee of signature generation")\
+	VTEST_DEFINE_TEST(130303, &test_sigGenApis, \
+		"Test rate and latency of each signing API per curve")\
+	VTEST_DEFINE_TEST(130304, &test_sigGenLowLatencyAmort, \
+		"Test amortization of activation for low latency signature")\
 	VTEST_DEFINE_TEST(130401, &test_sigVerifLatencyLoaded, \
 		"Test latency of signature verification")\
 	VTEST_DEFINE_TEST(130402, &test_sigVerifLatencyUnloaded, \
 		"Test latency of signature verification")\
+	VTEST_DEFINE_TEST(130403, &test_sigVerifLatencyOpenLoopFixed, \
+		"Test latency of signature verification, fixed rate load")\
+	VTEST_DEFINE_TEST(130404, &test_sigVerifLatencyOpenLoopPoisson, \
+		"Test latency of signature verification, Poisson load")\
 	VTEST_DEFINE_TEST(130501, &test_sigGenLatencyLoaded, \
 		"Test latency of signature generation")\
 	VTEST_DEFINE_TEST(130502, &test_sigGenLatencyUnloaded, \
 		"Test latency of signature generation")\
+	VTEST_DEFINE_TEST(130503, &test_sigGenPeriodicLoaded, \
+		"Test periodic signature generation deadlines with load")\
+	VTEST_DEFINE_TEST(130504, &test_sigGenPeriodicUnloaded, \
+		"Test periodic signature generation deadlines")\
+	VTEST_DEFINE_TEST(130601, &test_hashRate, \
+		"Test throughput of ecdsa library hash functions")\
+	VTEST_DEFINE_TEST(130701, &test_keyDerivRate, \
+		"Test rate of butterfly key derivation in batches")\
+	VTEST_DEFINE_TEST(130702, &test_pseudonymChurn, \
+		"Test pseudonym change churn: create, sign, delete keys")\
+	VTEST_DEFINE_TEST(130801, &test_eciesRate, \
+		"Test rate and latency of ECIES encryption / decryption")\
+	VTEST_DEFINE_TEST(130802, &test_sm2EcesRate, \
+		"Test rate and latency of SM2 ECES encryption / decryption")\
+	VTEST_DEFINE_TEST(130803, &test_rtCipherRate, \
+		"Test throughput and latency of Rt symmetric cipher")\
+	VTEST_DEFINE_TEST(130804, &test_rtCipherStream, \
+		"Test bulk throughput of Rt symmetric cipher, streaming")\
+	VTEST_DEFINE_TEST(130901, &test_rngRate, \
+		"Test throughput of SE random number generator")\
 	VTEST_DEFINE_TEST(140201, &test_sigGenVerifRate, \
 		"Test rate of parallel signature verifications / generations")\
+	VTEST_DEFINE_TEST(140202, &test_seApiContention, \
+		"Profile contention of v2xSe API calls from several threads")\
 
 void test_sigVerifRate(void);
+void test_sigVerifRateDepth(void);
+void test_sigVerifKnee(void);
+void test_sigVerifRateThreads(void);
+void test_sigVerifCurves(void);
+void test_sigVerifMsgSize(void);
+void test_sigVerifPreHash(void);
+void test_sigVerifDecomp(void);
+void test_pubKeyReconRate(void);
+void test_certChainRate(void);
 void test_sigGenRate(void);
+void test_sigGenKnee(void);
+void test_sigGenApis(void);
+void test_sigGenLowLatencyAmort(void);
 void test_sigVerifLatencyLoaded(void);
 void test_sigVerifLatencyUnloaded(void);
+void test_sigVerifLatencyOpenLoopFixed(void);
+void test_sigVerifLatencyOpenLoopPoisson(void);
 void test_sigGenLatencyLoaded(void);
 void test_sigGenLatencyUnloaded(void);
+void test_sigGenPeriodicLoaded(void);
+void test_sigGenPeriodicUnloaded(void);
+void test_hashRate(void);
+void test_keyDerivRate(void);
+void test_pseudonymChurn(void);
+void test_eciesRate(void);
+void test_sm2EcesRate(void);
+void test_rtCipherRate(void);
+void test_rtCipherStream(void);
+void test_rngRate(void);
 void test_sigGenVerifRate(void);
+void test_seApiContention(void);
 
 /** Number of keys to use for signing in performance tests */
 #define NUM_KEYS_PERF_TESTS	5
@@ -83,28 +158,210 @@ void test_sigGenVerifRate(void);
 #define SIG_VERIF_RATE_THRESHOLD_SECOFW	600
 /** Number of bytes used for the message for the verification rate test */
 #define SIG_VERIF_RATE_MSG_SIZE		300
+/** Number of signature verifications in flight for verification rate test */
+#define SIG_VERIF_RATE_DEPTH		1
+/** Number of depths (1, 2, 4...) measured by verification rate depth test */
+#define SIG_VERIF_DEPTH_STEPS		7
+/** Verification rate within this % of max rate is considered saturated */
+#define SIG_VERIF_DEPTH_SATURATION_PCT	5
+/** Max number of threads submitting verifications in threads rate test */
+#define SIG_VERIF_MAX_THREADS		8
+/** Number of verifications in flight per thread for threads rate test */
+#define SIG_VERIF_THREAD_DEPTH		1
+/** Time to measure each thread count of threads rate test, in seconds */
+#define SIG_VERIF_THREADS_SECONDS	2
+/** Number of curves measured by curve matrix tests */
+#define PERF_NUM_CURVES			6
+/** Number of signatures verified per curve in curve matrix test */
+#define SIG_CURVE_VERIF_NUM		1000l
+/** Number of signature verifications in flight for curve rate test */
+#define SIG_VERIF_CURVE_DEPTH		16
+/** Smallest message size of verification message size sweep, in bytes */
+#define SIG_MSG_SWEEP_MIN_SIZE		32
+/** Largest message size of verification message size sweep, in bytes */
+#define SIG_MSG_SWEEP_MAX_SIZE		65536
+/** Number of messages verified per size of message size sweep */
+#define SIG_MSG_SWEEP_NUM		200l
+/** Number of signature verifications in flight for message size sweep */
+#define SIG_MSG_SWEEP_DEPTH		16
+/** Max number of host threads hashing messages in pre-hashing test */
+#define SIG_PREHASH_MAX_THREADS		4
+/** Number of modes measured by public key decompression test */
+#define DECOMP_NUM_MODES		3
+/** Decompression mode: ecdsa_decompress_public_key only */
+#define DECOMP_MODE_DECOMP		1
+/** Decompression mode: decompress, then ecdsa_verify_signature */
+#define DECOMP_MODE_DECOMP_THEN_VERIF	2
+/** Decompression mode: ecdsa_decompress_and_verify_signature */
+#define DECOMP_MODE_FUSED		3
+/** Number of public key reconstructions in flight for rate test */
+#define PUBKEY_RECON_DEPTH		16
+/** Number of chains validated, each using two signatures of test data */
+#define CHAIN_NUM			(SIG_CURVE_VERIF_NUM / 2)
+/** Max number of chains validated in parallel */
+#define CHAIN_MAX_DEPTH			16
 
 /** Number of signatures generated during signature generation rate test */
 #define SIG_RATE_GEN_NUM 400l
 /** Signature generation rate pass/fail threshold */
 #define SIG_GEN_RATE_THRESHOLD		200
+/** Number of signing APIs measured by signing API matrix test */
+#define SIG_API_NUM			4
+/** Signing API: v2xSe_createRtSign */
+#define SIG_API_RT			0
+/** Signing API: v2xSe_createRtSignLowLatency */
+#define SIG_API_RT_LOW_LATENCY		1
+/** Signing API: v2xSe_createBaSign */
+#define SIG_API_BA			2
+/** Signing API: v2xSe_createMaSign */
+#define SIG_API_MA			3
+/** Number of low latency signatures per case of amortization test */
+#define LL_AMORT_NUM_SIGS		128
+/** Max number of signatures per activation, in powers of 4 from 1 */
+#define LL_AMORT_MAX_SIGS_PER_ACTIVATION	64
+/** Number of idle times measured by amortization test */
+#define LL_AMORT_NUM_IDLE		3
+/** Idle times between activation and signature, in ms */
+#define LL_AMORT_IDLE_MS		{0, 10, 100}
 
 /** Number of signatures verified during signature verification latency test */
 #define SIG_LATENCY_VERIF_NUM 1000
+/** Vehicles sending messages in open loop verif latency test, V2X HSM */
+#define SIG_VERIF_OPEN_LOOP_VEHICLES_V2XFW	200
+/** Vehicles sending messages in open loop verif latency test, SECO HSM */
+#define SIG_VERIF_OPEN_LOOP_VEHICLES_SECOFW	48
+/** Messages per second sent by each vehicle in open loop latency test */
+#define SIG_VERIF_OPEN_LOOP_MSG_HZ	10
+/** Seed for random intervals of Poisson arrivals, for repeatable runs */
+#define SIG_VERIF_OPEN_LOOP_SEED	1
 /** Number of signatures generated during signature generation latency test */
 #define SIG_LATENCY_GEN_NUM 1000
-/** Init value for min latency (ns) = 100s, 1st measurement should be lower */
-#define SIG_LATENCY_MIN_INIT	100000000000
-/** Init value for max latency (ns) = 0s, 1st measurement should be higher */
-#define SIG_LATENCY_MAX_INIT	0
 /** Signature verification latency pass/fail threshold */
 #define SIG_VERIF_LATENCY_THRESHOLD	10.0f
 /** Signature generation latency pass/fail threshold */
 #define SIG_GEN_LATENCY_THRESHOLD	10.0f
+/** Percentile of latency compared to latency thresholds, 100.0f for max */
+#define SIG_LATENCY_CHECK_PERCENTILE	100.0f
+/** Set to 1 to also compare max latency when checking a lower percentile */
+#define SIG_LATENCY_CHECK_MAX		0
+/** Number of periods measured by periodic signature test */
+#define SIG_PERIODIC_NUM_PERIODS	3
+/** Periods of periodic signature test, in ms */
+#define SIG_PERIODIC_PERIODS_MS		{100, 50, 10}
+/** Number of signatures generated per period of periodic signature test */
+#define SIG_PERIODIC_NUM		100
+/** Deadline for signature completion after periodic release, in ms */
+#define SIG_PERIODIC_DEADLINE_MS	10
+/** Deadline misses allowed per period of periodic signature test */
+#define SIG_PERIODIC_MAX_MISSES		0
+
+/** Number of load steps in throughput/latency knee tests */
+#define SIG_KNEE_STEPS			10
+/** Offered load increment per knee test step, as % of rate requirement */
+#define SIG_KNEE_STEP_PCT		25
+/** Achieved rate more than this % below offered rate is saturated */
+#define SIG_KNEE_SATURATION_PCT		5
+/** Number of signatures verified per step of verification knee test */
+#define SIG_KNEE_VERIF_NUM		2000l
+/** Number of signatures generated per step of generation knee test */
+#define SIG_KNEE_GEN_NUM		200l
+/** Max lag (ms) behind schedule before generation knee step is saturated */
+#define SIG_KNEE_MAX_LAG_MS		1000
 
 /** Time duration of parallel signature generation / verification test */
 #define SIG_GEN_VERIF_TIME_SECONDS 10
 
+/** Max number of threads calling each API in v2xSe contention test */
+#define SE_CONTENTION_MAX_THREADS	8
+/** Time to run each step of v2xSe contention test, in seconds */
+#define SE_CONTENTION_SECONDS		1
+/** Number of bytes requested by getRandomNumber in contention test */
+#define SE_CONTENTION_RND_SIZE		32
+/** Number of APIs called in v2xSe contention test */
+#define SE_CONTENTION_NUM_OPS		4
+/** Contention test API: v2xSe_createRtSign */
+#define SE_OP_CREATE_RT_SIGN		0
+/** Contention test API: v2xSe_getRandomNumber */
+#define SE_OP_GET_RANDOM		1
+/** Contention test API: v2xSe_getRtEccPublicKey */
+#define SE_OP_GET_RT_PUBKEY		2
+/** Contention test API: v2xSe_encryptUsingEcies */
+#define SE_OP_ENCRYPT_ECIES		3
+
+/** Number of hash functions measured by hash benchmark */
+#define HASH_BENCH_NUM_TYPES		3
+/** Hash benchmark function: ecdsa_sha256 */
+#define HASH_BENCH_SHA256		0
+/** Hash benchmark function: ecdsa_sha384 */
+#define HASH_BENCH_SHA384		1
+/** Hash benchmark function: ecdsa_sm3 */
+#define HASH_BENCH_SM3			2
+/** Smallest message size of hash benchmark, in bytes */
+#define HASH_BENCH_MIN_SIZE		64
+/** Largest message size of hash benchmark, in bytes */
+#define HASH_BENCH_MAX_SIZE		65536
+/** Max number of threads hashing in parallel in hash benchmark */
+#define HASH_BENCH_MAX_THREADS		4
+/** Number of bytes hashed by each thread per step of hash benchmark */
+#define HASH_BENCH_BYTES		(4 * 1024 * 1024l)
+
+/** Number of keys derived in key derivation batch, one week of certs */
+#define KEY_DERIV_BATCH_NUM		420
+/** Ba key slot used for key derivation test */
+#define KEY_DERIV_BA_SLOT		0
+/** Number of pseudonym changes per case of pseudonym churn test */
+#define PSEUDO_CHURN_CYCLES		50
+/** Number of Rt slots rotated through by pseudonym churn test */
+#define PSEUDO_CHURN_SLOTS		8
+/** Number of pseudonym change rates measured by churn test */
+#define PSEUDO_CHURN_NUM_RATES		3
+/** Pseudonym change rates in Hz, 0 to change back to back */
+#define PSEUDO_CHURN_RATES_HZ		{0, 20, 5}
+
+/** Number of key classes measured by ECIES benchmark */
+#define ECIES_BENCH_NUM_KEY_CLASSES	3
+/** ECIES benchmark key class: Rt keys */
+#define ECIES_KEY_RT			0
+/** ECIES benchmark key class: Ba key */
+#define ECIES_KEY_BA			1
+/** ECIES benchmark key class: Ma key */
+#define ECIES_KEY_MA			2
+/** Number of messages encrypted / decrypted per case of ECIES benchmark */
+#define ECIES_BENCH_NUM			100
+/** Number of recipient Rt key slots rotated through by ECIES benchmark */
+#define ECIES_BENCH_RT_SLOTS		4
+/** Smallest message size of ECIES benchmark, in bytes */
+#define ECIES_BENCH_MIN_SIZE		16
+/** MAC length used by ECIES benchmark, in bytes */
+#define ECIES_BENCH_MAC_LEN		16
+/** Max number of message sizes measured by ECIES benchmark */
+#define ECIES_BENCH_MAX_SIZES		8
+/** Number of encryption schemes measured by ECIES benchmark */
+#define ECIES_BENCH_NUM_SCHEMES		2
+/** ECIES benchmark scheme: ECIES with NIST P256 keys */
+#define ECIES_SCHEME_ECIES		0
+/** ECIES benchmark scheme: SM2 ECES with SM2 keys */
+#define ECIES_SCHEME_SM2_ECES		1
+
+/** Number of Rt cipher algorithms measured by cipher benchmarks */
+#define CIPHER_BENCH_NUM_ALGOS		3
+/** Rt cipher algorithms measured by cipher benchmarks */
+#define CIPHER_BENCH_ALGOS	{V2XSE_ALGO_SM4_ECB, V2XSE_ALGO_SM4_CBC, \
+							V2XSE_ALGO_SM4_CCM}
+/** Block size of Rt cipher algorithms, in bytes */
+#define CIPHER_BENCH_BLOCK_SIZE		16
+/** Number of buffers encrypted / decrypted per case of cipher benchmark */
+#define CIPHER_BENCH_NUM		100
+/** Size of payload of streaming cipher benchmark, in bytes */
+#define CIPHER_STREAM_BYTES		(64 * 1024)
+/** Max number of worker threads of streaming cipher benchmark */
+#define CIPHER_STREAM_MAX_THREADS	4
+
+/** Number of v2xSe_getRandomNumber calls per case of random number test */
+#define RNG_BENCH_CALLS			1000
+/** Max number of threads requesting random numbers in parallel */
+#define RNG_BENCH_MAX_THREADS		4
+
 /** Test type - sig verif rate */
 #define TEST_TYPE_SIG_VERIF_RATE	0
 /** Test type - sig gen rate */
@@ -113,6 +370,13 @@ void test_sigGenVerifRate(void);
 #define TEST_TYPE_SIG_VERIF_LATENCY	2
 /** Test type - sig gen rate */
 #define TEST_TYPE_SIG_GEN_LATENCY	3
+/** Test type - sig verif of hashes on perfCurve */
+#define TEST_TYPE_SIG_VERIF_CURVE	4
+
+/** Open loop test sends at a constant rate */
+#define OPEN_LOOP_FIXED_RATE	0
+/** Open loop test sends with Poisson arrivals */
+#define OPEN_LOOP_POISSON	1
 
 /** Test should be with in loaded system */
 #define LOADED_TEST		0
@@ -138,11 +402,30 @@ do {									\
 	diff -= start.tv_nsec;						\
 } while (0)
 
-#endif
-
 /** This structure holds plain text data (input message) */
 typedef struct
 {
 	/** Plain text data */
 	uint8_t data[SIG_VERIF_RATE_MSG_SIZE];
 } TypePlainTextMsg_t;
+
+/** This structure holds the result of one open loop load step */
+typedef struct
+{
+	/** Offered operation rate, per second */
+	long offeredRate;
+	/** Achieved operation rate, per second */
+	long achievedRate;
+	/** Median latency, in ns */
+	long p50Ns;
+	/** 99th percentile latency, in ns */
+	long p99Ns;
+	/** Max latency, in ns */
+	long maxNs;
+	/** Max lag of operation start behind schedule, in ns */
+	long maxLagNs;
+	/** Set if the system did not keep up with the offered rate */
+	int saturated;
+} TypeLoadStepResult_t;
+
+#endif
@@ -46,6 +46,8 @@
 
 #include <stdio.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <time.h>
 #include "vtest.h"
 
 /** Count value for async calls */
@@ -55,44 +57,132 @@
 #define TIME_UNIT_1_MS  1000
 /** 10ms time unit in us*/
 #define TIME_UNIT_10_MS 10000
+/** 1s time unit in us*/
+#define TIME_UNIT_1_S   (TIME_UNIT_1_MS*1000)
 
-/** Macro used to call async API */
+/** Timeout for a loop of async API calls, in us */
+#define ASYNC_LOOP_TIMEOUT (60*TIME_UNIT_1_S)
+
+/** Number of request slots, i.e. max async calls tracked in parallel */
+#define ASYNC_REQ_SLOTS 128
+
+/** Request slot is not in use */
+#define ASYNC_REQ_FREE		0
+/** Request slot is waiting for its callback */
+#define ASYNC_REQ_PENDING	1
+
+/** Async operation type: ecdsa_verify_signature */
+#define ASYNC_OP_VERIF_HASH		0
+/** Async operation type: ecdsa_verify_signature_of_message */
+#define ASYNC_OP_VERIF_MSG		1
+/** Async operation type: ecdsa_decompress_and_verify_signature */
+#define ASYNC_OP_DECOMP_VERIF_HASH	2
+/** Async operation type: ecdsa_decompress_and_verify_signature_of_message */
+#define ASYNC_OP_DECOMP_VERIF_MSG	3
+/** Async operation type: ecdsa_decompress_public_key */
+#define ASYNC_OP_DECOMP			4
+/** Async operation type: ecdsa_reconstruct_public_key */
+#define ASYNC_OP_RECONSTRUCT		5
+
+/** Tracking data for one async API call */
+typedef struct {
+	/** Time the call was issued (CLOCK_BOOTTIME) */
+	struct timespec issueTime;
+	/** Latency of the call in ns, set when the callback is received */
+	long nsLatency;
+	/** Operation type, one of ASYNC_OP_* */
+	int opType;
+	/** Expected result of the operation */
+	int expResult;
+	/** ASYNC_REQ_FREE or ASYNC_REQ_PENDING */
+	int state;
+	/** Tag set by the test, e.g. submitter or data index of the call */
+	int owner;
+} vtestAsyncReq_t;
+
+/** Completion counter and request slots for outstanding async API calls */
+typedef struct {
+	/** Lock protecting the counter and the request slots */
+	pthread_mutex_t lock;
+	/** Signalled when the counter drops to ASYNC_COUNT_RESET */
+	pthread_cond_t done;
+	/** Number of async calls still waiting for their callback */
+	int count;
+	/** Next slot to try when issuing a request */
+	int nextSlot;
+	/** Number of duplicated or unknown callbacks received */
+	int numBadCallbacks;
+	/** Request slots, passed as sequence_number to the ecdsa API */
+	vtestAsyncReq_t slots[ASYNC_REQ_SLOTS];
+} vtestAsync_t;
+
+/** Static initializer for vtestAsync_t */
+#define VTEST_ASYNC_INITIALIZER						\
+	{PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, ASYNC_COUNT_RESET}
+
+void vtestAsyncInc(vtestAsync_t *async);
+void vtestAsyncDec(vtestAsync_t *async);
+int vtestAsyncWait(vtestAsync_t *async, long timeoutUs);
+int vtestAsyncReset(vtestAsync_t *async);
+void *vtestAsyncReqIssue(vtestAsync_t *async, int opType, int expResult);
+void *vtestAsyncReqIssueAt(vtestAsync_t *async, int opType, int expResult,
+					const struct timespec *sendTime);
+int vtestAsyncReqComplete(vtestAsync_t *async, void *sequence_number,
+						vtestAsyncReq_t *req);
+
+/** Request slot for a signature verification expected to succeed */
+#define REQ_VERIF_PASS(async, op) \
+	vtestAsyncReqIssue(async, op, ECDSA_VERIFICATION_SUCCESS)
+/** Request slot for a signature verification expected to fail */
+#define REQ_VERIF_FAIL(async, op) \
+	vtestAsyncReqIssue(async, op, ECDSA_VERIFICATION_ERROR)
+
+/**
+ * Macro used to call async API
+ * The count is raised before the call is made, so that a callback running
+ * before the API returns can never see the count drop to zero early.
+ */
 #define VTEST_CHECK_RESULT_ASYNC_INC(got, exp, count)			\
 do {									\
+	vtestAsyncInc(&(count));					\
 	checkResult(__FILE__, __LINE__, got, exp);			\
-	count++;							\
 } while (0)
 
-/** Macro used to signal a return from async API calls */
+/**
+ * Macro used to signal a return from async API calls
+ * Must be the last access to test data in the callback, as the waiting
+ * test is released as soon as the count drops to zero.
+ */
 #define VTEST_CHECK_RESULT_ASYNC_DEC(got, exp, count)			\
 do {									\
 	checkResult(__FILE__, __LINE__, got, exp);			\
-	count--;							\
+	vtestAsyncDec(&(count));					\
 } while (0)
 
-/** Macro used to wait returns from async API calls */
+/** Macro used to wait returns from async API calls, time is timeout in us */
 #define VTEST_CHECK_RESULT_ASYNC_WAIT(count, time)			\
 do {									\
-	usleep(time);							\
-	if (count > 0)							\
-		printf("%d missing responses!\n", count);		\
-	checkResult(__FILE__, __LINE__, count, ASYNC_COUNT_RESET);	\
-	count = ASYNC_COUNT_RESET;					\
+	int missing_async = vtestAsyncWait(&(count), time);		\
+	if (missing_async > 0)						\
+		printf("%d missing responses!\n", missing_async);	\
+	checkResult(__FILE__, __LINE__, missing_async,			\
+						ASYNC_COUNT_RESET);	\
+	checkResult(__FILE__, __LINE__, vtestAsyncReset(&(count)), 0);	\
 } while (0)
 
 /** Macro used to wait for loop of async API calls, 1 min timeout */
 #define VTEST_CHECK_RESULT_ASYNC_LOOP(count, loops)			\
 do {									\
-	int32_t timeout = 60;						\
-	while (loops && --timeout)					\
-		usleep(TIME_UNIT_10_MS*100);				\
+	int missing_async = vtestAsyncWait(&(count),			\
+					ASYNC_LOOP_TIMEOUT);		\
 	checkResult(__FILE__, __LINE__, loops, 0);			\
 	if (loops > 0)							\
 		loops = -1;						\
-	if (count > 0)							\
-		printf("%d missing responses!\n", count);		\
-	checkResult(__FILE__, __LINE__, count, ASYNC_COUNT_RESET);	\
-	count = ASYNC_COUNT_RESET;					\
+	if (missing_async > 0)						\
+		printf("%d missing responses!\n", missing_async);	\
+	checkResult(__FILE__, __LINE__, missing_async,			\
+						ASYNC_COUNT_RESET);	\
+	checkResult(__FILE__, __LINE__, vtestAsyncReset(&(count)), 0);	\
 } while (0)
 
 #endif
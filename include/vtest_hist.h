@@ -0,0 +1,80 @@
+
+/*
+ * Copyright 2019 NXP
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON  ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS  SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ *
+ * @file vtest_hist.h
+ *
+ * @brief Header file for V2X test latency histograms
+ *
+ */
+
+#ifndef VTEST_HIST_H
+#define VTEST_HIST_H
+
+#include <stdint.h>
+
+/**
+ * Number of bits of precision kept for each recorded value: values are
+ * counted in buckets no wider than 1/16 of the value (~6% resolution)
+ */
+#define HIST_SUB_BUCKET_BITS	4
+/** Number of sub-buckets per power of 2 */
+#define HIST_SUB_BUCKETS	(1 << HIST_SUB_BUCKET_BITS)
+/** Total number of buckets, covers all positive long values */
+#define HIST_NUM_BUCKETS	(64 * HIST_SUB_BUCKETS)
+
+/**
+ * Log-bucketed histogram of latency values, in ns
+ * Values can be recorded from several threads in parallel without locking,
+ * all updates are done with atomic operations.
+ */
+typedef struct {
+	/** Number of values recorded in each bucket */
+	uint32_t buckets[HIST_NUM_BUCKETS];
+	/** Total number of values recorded */
+	long count;
+	/** Lowest value recorded */
+	long min;
+	/** Highest value recorded */
+	long max;
+} vtestHist_t;
+
+void vtestHistReset(vtestHist_t *hist);
+void vtestHistRecord(vtestHist_t *hist, long value);
+long vtestHistPercentile(vtestHist_t *hist, float percentile);
+void vtestHistLog(vtestHist_t *hist, char *name);
+
+#endif
@@ -47,7 +47,7 @@
 #include "vtest_async.h"
 #include "ECCcrypto_data.h"
 
-static volatile int count_async = ASYNC_COUNT_RESET;
+static vtestAsync_t count_async = VTEST_ASYNC_INITIALIZER;
 
 /** Result of memcmp when values match */
 #define MEMCMP_IDENTICAL      0
@@ -57,7 +57,7 @@ static volatile int count_async = ASYNC_COUNT_RESET;
 /**
  * @brief   Signature verification with compressed key callback
  *
- * @param[in]  sequence_number          sequence operation id (not used?)
+ * @param[in]  sequence_number          request slot of the operation
  * @param[in] ret                      returned value by the dispatcher
  * @param[in] decompressed_public_key  public key in decompressed form
  * @param[in] verification_result      verification result
@@ -68,20 +68,25 @@ void ecdsa_VerifSigCompOfHashNistP256Callback(void *sequence_number,
 	ecdsa_pubkey_t *decompressed_public_key,
 	ecdsa_verification_result_t verification_result)
 {
+	vtestAsyncReq_t req;
+
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
 	/* Check signature verification is correct */
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 
 	/* Check decompressed public key is correct */
 	VTEST_CHECK_RESULT(memcmp((const void *)decompressed_public_key->y,
 			(const void *)test_ver_pubKey_y_nistp256,
 		LENGTH_DOMAIN_PARAMS_256), MEMCMP_IDENTICAL);
+
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
  * @brief   Signature verification with compressed key callback
  *
- * @param[in]  sequence_number          sequence operation id (not used?)
+ * @param[in]  sequence_number          request slot of the operation
  * @param[in] ret                      returned value by the dispatcher
  * @param[in] decompressed_public_key  public key in decompressed form
  * @param[in] verification_result      verification result
@@ -92,20 +97,25 @@ void ecdsa_VerifSigCompOfHashBP256T1Callback(void *sequence_number,
 	ecdsa_pubkey_t *decompressed_public_key,
 	ecdsa_verification_result_t verification_result)
 {
+	vtestAsyncReq_t req;
+
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
 	/* Check signature verification is correct */
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 
 	/* Check decompressed public key is correct */
 	VTEST_CHECK_RESULT(memcmp((const void *)decompressed_public_key->y,
 			(const void *)test_ver_pubKey_y_bp256t1,
 		LENGTH_DOMAIN_PARAMS_256), MEMCMP_IDENTICAL);
+
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
  * @brief   Signature verification with compressed key callback
  *
- * @param[in]  sequence_number          sequence operation id (not used?)
+ * @param[in]  sequence_number          request slot of the operation
  * @param[in] ret                      returned value by the dispatcher
  * @param[in] decompressed_public_key  public key in decompressed form
  * @param[in] verification_result      verification result
@@ -116,20 +126,25 @@ void ecdsa_VerifSigCompOfHashBP256R1Callback(void *sequence_number,
 	ecdsa_pubkey_t *decompressed_public_key,
 	ecdsa_verification_result_t verification_result)
 {
+	vtestAsyncReq_t req;
+
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
 	/* Check signature verification is correct */
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 
 	/* Check decompressed public key is correct */
 	VTEST_CHECK_RESULT(memcmp((const void *)decompressed_public_key->y,
 			(const void *)test_ver_pubKey_y_bp256r1,
 		LENGTH_DOMAIN_PARAMS_256), MEMCMP_IDENTICAL);
+
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
  * @brief   Signature verification with compressed key callback
  *
- * @param[in]  sequence_number          sequence operation id (not used?)
+ * @param[in]  sequence_number          request slot of the operation
  * @param[in] ret                      returned value by the dispatcher
  * @param[in] decompressed_public_key  public key in decompressed form
  * @param[in] verification_result      verification result
@@ -140,20 +155,25 @@ void ecdsa_VerifSigCompOfHashBP384R1Callback(void *sequence_number,
 	ecdsa_pubkey_t *decompressed_public_key,
 	ecdsa_verification_result_t verification_result)
 {
+	vtestAsyncReq_t req;
+
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
 	/* Check signature verification is correct */
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 
 	/* Check decompressed public key is correct */
 	VTEST_CHECK_RESULT(memcmp((const void *)decompressed_public_key->y,
 			(const void *)test_ver_pubKey_y_bp384r1,
 		LENGTH_DOMAIN_PARAMS_384), MEMCMP_IDENTICAL);
+
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
  * @brief   Signature verification with compressed key callback
  *
- * @param[in]  sequence_number          sequence operation id (not used?)
+ * @param[in]  sequence_number          request slot of the operation
  * @param[in] ret                      returned value by the dispatcher
  * @param[in] decompressed_public_key  public key in decompressed form
  * @param[in] verification_result      verification result
@@ -164,20 +184,25 @@ void ecdsa_VerifSigCompOfHashBP384T1Callback(void *sequence_number,
 	ecdsa_pubkey_t *decompressed_public_key,
 	ecdsa_verification_result_t verification_result)
 {
+	vtestAsyncReq_t req;
+
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
 	/* Check signature verification is correct */
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 
 	/* Check decompressed public key is correct */
 	VTEST_CHECK_RESULT(memcmp((const void *)decompressed_public_key->y,
 			(const void *)test_ver_pubKey_y_bp384t1,
 		LENGTH_DOMAIN_PARAMS_384), MEMCMP_IDENTICAL);
+
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
  * @brief   Signature verification callback: positive test
  *
- * @param[in]  sequence_number       sequence operation id (not used?)
+ * @param[in]  sequence_number       request slot of the operation
  * @param[in] ret                   returned value by the dispatcher
  * @param[in] verification_result   verification result
  *
@@ -187,14 +212,18 @@ void ecdsa_VerifSigOfHashCallback(void *sequence_number,
 	int ret,
 	ecdsa_verification_result_t verification_result)
 {
+	vtestAsyncReq_t req;
+
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
 }
 
 /**
  * @brief   Signature verification callback: negative test
  *
- * @param[in]  sequence_number       sequence operation id (not used?)
+ * @param[in]  sequence_number       request slot of the operation
  * @param[in] ret                   returned value by the dispatcher
  * @param[in] verification_result   verification result
  *
@@ -203,14 +232,17 @@ void ecdsa_VerifSigOfHashCallback_negative(void *sequence_number,
 	int ret,
 	ecdsa_verification_result_t verification_result)
 {
-#if LEGACY_SECO_LIBS
+	vtestAsyncReq_t req;
+
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 
+#if LEGACY_SECO_LIBS
 	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 #else
 	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_EXECUTER_ERROR, count_async);
 #endif
-	VTEST_CHECK_RESULT(verification_result,
-		ECDSA_VERIFICATION_ERROR);
 }
 
 /**
@@ -230,8 +262,6 @@ void my_ecdsa_DecompressPubKeyCallback(void *callbackData,
 	/* Callback data used to store curve id */
 	curveID = *(ecdsa_curveid_t *) callbackData;
 
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-
 	switch (curveID) {
 	/*
 	 * Compare decompressed and expected Y-coordinate
@@ -275,6 +305,8 @@ void my_ecdsa_DecompressPubKeyCallback(void *callbackData,
 		VTEST_CHECK_RESULT(curveID, ECDSA_CURVE_NOT_SUPP);
 		break;
 	}
+
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
@@ -294,8 +326,6 @@ void my_ecdsa_DecompressPubKeyCallback_negative(void *callbackData,
 	/* Callback data used to store curve id */
 	curveID = *(ecdsa_curveid_t *) callbackData;
 
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR,	count_async);
-
 	switch (curveID) {
 	/*
 	 * Compare decompressed and expected Y. They must be different.
@@ -346,6 +376,8 @@ void my_ecdsa_DecompressPubKeyCallback_negative(void *callbackData,
 		VTEST_CHECK_RESULT(curveID, ECDSA_CURVE_NOT_SUPP);
 		break;
 	}
+
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR,	count_async);
 }
 
 /**
@@ -364,8 +396,6 @@ static void my_ecdsa_ReconPubKeyCallback(void *callbackData,
 	/* Use callback data to store curve id */
 	curveID = *(ecdsa_curveid_t *) callbackData;
 
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-
 	switch (curveID) {
 
 	case ECDSA_CURVE_NISTP256:
@@ -410,6 +440,8 @@ static void my_ecdsa_ReconPubKeyCallback(void *callbackData,
 		VTEST_CHECK_RESULT(curveID, ECDSA_CURVE_NOT_SUPP);
 		break;
 	}
+
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
@@ -428,8 +460,6 @@ static void my_ecdsa_ReconPubKeyCallback_negative(void *callbackData,
 	/* Use callback data to store curve id */
 	curveID = *(ecdsa_curveid_t *) callbackData;
 
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_EXECUTER_ERROR, count_async);
-
 	switch (curveID) {
 
 	case ECDSA_CURVE_NISTP256:
@@ -474,6 +504,8 @@ static void my_ecdsa_ReconPubKeyCallback_negative(void *callbackData,
 		VTEST_CHECK_RESULT(curveID, ECDSA_CURVE_NOT_SUPP);
 		break;
 	}
+
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_EXECUTER_ERROR, count_async);
 }
 
 static void ecc_test_signature_verification_t1(void)
@@ -490,7 +522,8 @@ static void ecc_test_signature_verification_t1(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_bp256t1;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_BP256T1, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -502,7 +535,8 @@ static void ecc_test_signature_verification_t1(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_bp384t1;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_BP384T1, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 }
@@ -528,7 +562,8 @@ void ecc_test_signature_verification(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_256;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_NISTP256, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -540,7 +575,8 @@ void ecc_test_signature_verification(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_256;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_BP256R1, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -552,7 +588,8 @@ void ecc_test_signature_verification(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_384;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_BP384R1, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -581,7 +618,8 @@ static void ecc_test_signature_verification_message_t1(void)
 		ecdsa_verify_signature_of_message(ECDSA_CURVE_BP256T1, pubKey,
 			(const void *)test_ver_msg_bp256t1,
 			sizeof (test_ver_msg_bp256t1), sig, 0,
-			ecdsa_VerifSigOfHashCallback, (void *)0),
+			ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -594,7 +632,8 @@ static void ecc_test_signature_verification_message_t1(void)
 		ecdsa_verify_signature_of_message(ECDSA_CURVE_BP384T1, pubKey,
 			(const void *)test_ver_msg_bp384t1,
 			sizeof (test_ver_msg_bp384t1), sig, 0,
-			ecdsa_VerifSigOfHashCallback, (void *)0),
+			ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 }
@@ -619,7 +658,8 @@ void ecc_test_signature_verification_message(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256, pubKey,
 			(const void *)test_ver_msg, HASH_MSG_SIZE, sig, 0,
-			ecdsa_VerifSigOfHashCallback, (void *)0),
+			ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -631,7 +671,8 @@ void ecc_test_signature_verification_message(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature_of_message(ECDSA_CURVE_BP256R1, pubKey,
 			(const void *)test_ver_msg, HASH_MSG_SIZE, sig, 0,
-			ecdsa_VerifSigOfHashCallback, (void *)0),
+			ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -643,7 +684,8 @@ void ecc_test_signature_verification_message(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature_of_message(ECDSA_CURVE_BP384R1, pubKey,
 			(const void *)test_ver_msg, HASH_MSG_SIZE, sig, 0,
-			ecdsa_VerifSigOfHashCallback, (void *)0),
+			ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -673,7 +715,8 @@ static void ecc_test_signature_verification_negative_t1(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_256;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_BP256T1, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback_negative, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback_negative,
+			REQ_VERIF_FAIL(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -686,7 +729,8 @@ static void ecc_test_signature_verification_negative_t1(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_384;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_BP384T1, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback_negative, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback_negative,
+			REQ_VERIF_FAIL(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 }
@@ -713,7 +757,8 @@ void ecc_test_signature_verification_negative(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_256;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_NISTP256, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback_negative, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback_negative,
+			REQ_VERIF_FAIL(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -726,7 +771,8 @@ void ecc_test_signature_verification_negative(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_256;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_BP256R1, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback_negative, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback_negative,
+			REQ_VERIF_FAIL(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -739,7 +785,8 @@ void ecc_test_signature_verification_negative(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_384;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_BP384R1, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback_negative, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback_negative,
+			REQ_VERIF_FAIL(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -810,7 +857,8 @@ void ecc_test_sm2_signature_verification(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_sm2;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_SM2P256, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -839,7 +887,8 @@ void ecc_test_sm2_signature_verification_message(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature_of_message(ECDSA_CURVE_SM2P256, pubKey,
 			(const void *)test_ver_msg, HASH_MSG_SIZE, sig, 0,
-			ecdsa_VerifSigOfHashCallback, (void *)0),
+			ecdsa_VerifSigOfHashCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -870,7 +919,8 @@ void ecc_test_sm2_signature_verification_negative(void)
 	hash     = (ecdsa_hash_t) test_ver_hash_sm2;
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_verify_signature(ECDSA_CURVE_SM2P256, pubKey, hash,
-			sig, 0, ecdsa_VerifSigOfHashCallback_negative, (void *)0),
+			sig, 0, ecdsa_VerifSigOfHashCallback_negative,
+			REQ_VERIF_FAIL(&count_async, ASYNC_OP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -892,7 +942,8 @@ static void ecc_test_ecdsa_decompress_and_verify_signature_t1(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_decompress_and_verify_signature(ECDSA_CURVE_BP256T1,
 			pubKey, hash, sig, 0, ecdsa_VerifSigCompOfHashBP256T1Callback,
-			(void *)0),
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -905,7 +956,8 @@ static void ecc_test_ecdsa_decompress_and_verify_signature_t1(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_decompress_and_verify_signature(ECDSA_CURVE_BP384T1,
 			pubKey, hash, sig, 0, ecdsa_VerifSigCompOfHashBP384T1Callback,
-			(void *)0),
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 }
@@ -932,7 +984,8 @@ void ecc_test_ecdsa_decompress_and_verify_signature(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_decompress_and_verify_signature(ECDSA_CURVE_NISTP256,
 			pubKey, hash, sig, 0, ecdsa_VerifSigCompOfHashNistP256Callback,
-			(void *)0),
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -945,7 +998,8 @@ void ecc_test_ecdsa_decompress_and_verify_signature(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_decompress_and_verify_signature(ECDSA_CURVE_BP256R1,
 			pubKey, hash, sig, 0, ecdsa_VerifSigCompOfHashBP256R1Callback,
-			(void *)0),
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -958,7 +1012,8 @@ void ecc_test_ecdsa_decompress_and_verify_signature(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_decompress_and_verify_signature(ECDSA_CURVE_BP384R1,
 			pubKey, hash, sig, 0, ecdsa_VerifSigCompOfHashBP384R1Callback,
-			(void *)0),
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_HASH)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -987,7 +1042,9 @@ static void ecc_test_ecdsa_decompress_and_verify_signature_of_message_t1(void)
 		ecdsa_decompress_and_verify_signature_of_message(ECDSA_CURVE_BP256T1, pubKey,
 			(const void *)test_ver_msg_bp256t1,
 			sizeof (test_ver_msg_bp256t1), sig, 0,
-			ecdsa_VerifSigCompOfHashBP256T1Callback, (void *)0),
+			ecdsa_VerifSigCompOfHashBP256T1Callback,
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -1000,7 +1057,9 @@ static void ecc_test_ecdsa_decompress_and_verify_signature_of_message_t1(void)
 		ecdsa_decompress_and_verify_signature_of_message(ECDSA_CURVE_BP384T1, pubKey,
 			(const void *)test_ver_msg_bp384t1,
 			sizeof (test_ver_msg_bp384t1), sig, 0,
-			ecdsa_VerifSigCompOfHashBP384T1Callback, (void *)0),
+			ecdsa_VerifSigCompOfHashBP384T1Callback,
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 }
@@ -1025,7 +1084,9 @@ void ecc_test_ecdsa_decompress_and_verify_signature_of_message(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_decompress_and_verify_signature_of_message(ECDSA_CURVE_NISTP256, pubKey,
 			(const void *)test_ver_msg, HASH_MSG_SIZE, sig, 0,
-			ecdsa_VerifSigCompOfHashNistP256Callback, (void *)0),
+			ecdsa_VerifSigCompOfHashNistP256Callback,
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -1037,7 +1098,9 @@ void ecc_test_ecdsa_decompress_and_verify_signature_of_message(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_decompress_and_verify_signature_of_message(ECDSA_CURVE_BP256R1, pubKey,
 			(const void *)test_ver_msg, HASH_MSG_SIZE, sig, 0,
-			ecdsa_VerifSigCompOfHashBP256R1Callback, (void *)0),
+			ecdsa_VerifSigCompOfHashBP256R1Callback,
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -1049,7 +1112,9 @@ void ecc_test_ecdsa_decompress_and_verify_signature_of_message(void)
 	VTEST_CHECK_RESULT_ASYNC_INC(
 		ecdsa_decompress_and_verify_signature_of_message(ECDSA_CURVE_BP384R1, pubKey,
 			(const void *)test_ver_msg, HASH_MSG_SIZE, sig, 0,
-			ecdsa_VerifSigCompOfHashBP384R1Callback, (void *)0),
+			ecdsa_VerifSigCompOfHashBP384R1Callback,
+			REQ_VERIF_PASS(&count_async,
+				ASYNC_OP_DECOMP_VERIF_MSG)),
 		ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
 
@@ -41,10 +41,12 @@
  *
  */
 
+#include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include <v2xSe.h>
 #include "vtest.h"
+#include "vtest_hist.h"
 #include "SEmisc.h"
 #include "SEkeymanagement.h"
 
@@ -2426,125 +2428,287 @@ void test_activateRtKeyForSigning(void)
 	VTEST_FLAG_CONF();
 }
 
+/** Key type measured by key creation speed tests */
+typedef struct {
+	/** Key type name for log messages */
+	char *name;
+	/** Applet supporting the key type */
+	appletSelection_t applet;
+	/** Curve id, or symmetric key type for symmetric keys */
+	uint8_t keyType;
+	/** Set for symmetric keys, only supported as Rt keys */
+	int isSymmetric;
+	/** Set if the key type is only supported with V2X HW */
+	int needsV2xHw;
+} TypeKeySpeedType_t;
+
+/** Key types measured by key creation speed tests */
+static TypeKeySpeedType_t keySpeedTypes[KEY_SPEED_NUM_TYPES] = {
+	{"NISTP256", e_EU, V2XSE_CURVE_NISTP256, 0, 0},
+	{"BP256R1", e_EU, V2XSE_CURVE_BP256R1, 0, 0},
+	{"BP256T1", e_EU, V2XSE_CURVE_BP256T1, 0, 0},
+	{"NISTP384", e_EU, V2XSE_CURVE_NISTP384, 0, 0},
+	{"BP384R1", e_EU, V2XSE_CURVE_BP384R1, 0, 0},
+	{"BP384T1", e_EU, V2XSE_CURVE_BP384T1, 0, 0},
+	{"SM2P256", e_CN, V2XSE_CURVE_SM2_256, 0, 1},
+	{"SM4", e_CN, V2XSE_SYMMK_SM4_128, 1, 1}
+};
+
+/** Key creation latencies measured by key creation speed tests */
+static vtestHist_t keyCreateHist;
+/** Key deletion latencies measured by key creation speed tests */
+static vtestHist_t keyDeleteHist;
+
 /**
+ * @brief   Create a key for the key creation speed tests
  *
- * @brief Test speed of run time key creation
+ * @param keyClass KEY_CLASS_RT or KEY_CLASS_BA
+ * @param type type of key to create
+ * @param slot slot of the key
  *
- * This function tests the speed of run time key creation
- * The following behaviours are tested:
- *  - key generated in empty slot
- * TODO: try different key types, update, more keys for better accuracy
+ * @return V2XSE_SUCCESS or the error returned by the API
  *
  */
-void test_rtKeyCreationSpeed(void)
+static int32_t createSpeedKey(int keyClass, TypeKeySpeedType_t *type,
+								int slot)
 {
 	TypeSW_t statusCode;
 	TypePublicKey_t pubKey;
-	int i;
-	struct timespec startTime, endTime;
-	long nsTimeDiff;
-	float keySpeedMs;
 
-/* Measure speed of creating NIST P256 key in empty slot */
-	/* Move to ACTIVATED state, normal operating mode */
-	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
-
-	/* Log start time */
-	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
-		VTEST_FLAG_CONF();
-		return;
-	}
-
-	/* Create the keys */
-	for (i = 0; i < KEY_SPEED_CREATE_NUM; i++)
-		VTEST_CHECK_RESULT(v2xSe_generateRtEccKeyPair(i,
-				V2XSE_CURVE_NISTP256, &statusCode, &pubKey),
-								V2XSE_SUCCESS);
-	/* Log end time */
-	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
-		VTEST_FLAG_CONF();
-		return;
-	}
-
-	/* Delete keys after use */
-	for (i = 0; i < KEY_SPEED_CREATE_NUM; i++)
-		VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(i, &statusCode),
-								V2XSE_SUCCESS);
-
-	/* Calculate elapsed time and key create time */
-	nsTimeDiff = (endTime.tv_sec - startTime.tv_sec) * 1000000000;
-	nsTimeDiff += endTime.tv_nsec;
-	nsTimeDiff -= startTime.tv_nsec;
-	VTEST_LOG("Elapsed time for %d keys: %ld ns\n", KEY_SPEED_CREATE_NUM,
-								nsTimeDiff);
-	keySpeedMs = nsTimeDiff / (float)KEY_SPEED_CREATE_NUM / (float)1000000;
-	VTEST_LOG("Key creation time: %.2f ms\n", keySpeedMs);
+	if (keyClass == KEY_CLASS_BA)
+		return v2xSe_generateBaEccKeyPair(slot, type->keyType,
+						&statusCode, &pubKey);
+	if (type->isSymmetric)
+		return v2xSe_generateRtSymmetricKey(slot, type->keyType,
+								&statusCode);
+	return v2xSe_generateRtEccKeyPair(slot, type->keyType, &statusCode,
+								&pubKey);
+}
 
-/* Go back to init to leave system in known state after test */
-	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+/**
+ * @brief   Delete a key created by createSpeedKey
+ *
+ * @param keyClass KEY_CLASS_RT or KEY_CLASS_BA
+ * @param type type of key to delete
+ * @param slot slot of the key
+ *
+ * @return V2XSE_SUCCESS or the error returned by the API
+ *
+ */
+static int32_t deleteSpeedKey(int keyClass, TypeKeySpeedType_t *type,
+								int slot)
+{
+	TypeSW_t statusCode;
 
-	/* Need to define pass/fail criteria */
-	VTEST_FLAG_CONF();
+	if (keyClass == KEY_CLASS_BA)
+		return v2xSe_deleteBaEccPrivateKey(slot, &statusCode);
+	if (type->isSymmetric)
+		return v2xSe_deleteRtSymmetricKey(slot, &statusCode);
+	return v2xSe_deleteRtEccPrivateKey(slot, &statusCode);
 }
 
 /**
+ * @brief   Time creation of keys in all slots, then their deletion
  *
- * @brief Test speed of base key creation
+ * Keys are created in empty slots, in ascending or descending slot order,
+ * adding latencies to keyCreateHist and keyDeleteHist.  The mean
+ * creation time of the first and last KEY_SPEED_GROUP_SLOTS keys created
+ * is returned, to compare nearly empty and nearly full key storage.
  *
- * This function tests the speed of base key creation
- * The following behaviours are tested:
- *  - key generated in empty slot
- * TODO: try different key types, update, more keys for better accuracy
+ * @param keyClass KEY_CLASS_RT or KEY_CLASS_BA
+ * @param type type of keys to create
+ * @param numSlots number of slots to fill
+ * @param descending set to fill slots from the highest one
+ * @param firstMs mean creation time of first keys created, in ms
+ * @param lastMs mean creation time of last keys created, in ms
+ *
+ * @return VTEST_PASS, or VTEST_FAIL if time could not be measured, in
+ *         which case keys already created are still deleted
  *
  */
-void test_baKeyCreationSpeed(void)
+static int measureKeyCreation(int keyClass, TypeKeySpeedType_t *type,
+		int numSlots, int descending, float *firstMs, float *lastMs)
 {
-	TypeSW_t statusCode;
-	TypePublicKey_t pubKey;
-	int i;
 	struct timespec startTime, endTime;
 	long nsTimeDiff;
-	float keySpeedMs;
-
-/* Measure speed of creating NIST P256 key in empty slot */
-	/* Move to ACTIVATED state, normal operating mode */
-	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+	long nsFirst = 0;
+	long nsLast = 0;
+	int groupSlots;
+	int numCreated = 0;
+	int retVal = VTEST_PASS;
+	int slot;
+	int i;
 
-	/* Log start time */
-	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
-		VTEST_FLAG_CONF();
-		return;
+	groupSlots = (numSlots < KEY_SPEED_GROUP_SLOTS) ? numSlots :
+							KEY_SPEED_GROUP_SLOTS;
+
+	for (i = 0; i < numSlots; i++) {
+		slot = descending ? (numSlots - 1 - i) : i;
+		if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+			retVal = VTEST_FAIL;
+			break;
+		}
+		VTEST_CHECK_RESULT(createSpeedKey(keyClass, type, slot),
+								V2XSE_SUCCESS);
+		numCreated++;
+		if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
+			retVal = VTEST_FAIL;
+			break;
+		}
+		nsTimeDiff = (endTime.tv_sec - startTime.tv_sec) * 1000000000;
+		nsTimeDiff += endTime.tv_nsec;
+		nsTimeDiff -= startTime.tv_nsec;
+		vtestHistRecord(&keyCreateHist, nsTimeDiff);
+		if (i < groupSlots)
+			nsFirst += nsTimeDiff;
+		if (i >= numSlots - groupSlots)
+			nsLast += nsTimeDiff;
 	}
 
-	/* Create the keys */
-	for (i = 0; i < KEY_SPEED_CREATE_NUM; i++)
-		VTEST_CHECK_RESULT(v2xSe_generateBaEccKeyPair(i,
-			V2XSE_CURVE_NISTP256, &statusCode, &pubKey),
-								V2XSE_SUCCESS);
-
-	/* Log end time */
-	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
-		VTEST_FLAG_CONF();
-		return;
+	/* Delete keys after use, even if time could not be measured */
+	for (i = 0; i < numCreated; i++) {
+		slot = descending ? (numSlots - 1 - i) : i;
+		if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1)
+			retVal = VTEST_FAIL;
+		VTEST_CHECK_RESULT(deleteSpeedKey(keyClass, type, slot),
+								V2XSE_SUCCESS);
+		if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1)
+			retVal = VTEST_FAIL;
+		if (retVal != VTEST_PASS)
+			continue;
+		nsTimeDiff = (endTime.tv_sec - startTime.tv_sec) * 1000000000;
+		nsTimeDiff += endTime.tv_nsec;
+		nsTimeDiff -= startTime.tv_nsec;
+		vtestHistRecord(&keyDeleteHist, nsTimeDiff);
 	}
 
-	/* Delete keys after use */
-	for (i = 0; i < KEY_SPEED_CREATE_NUM; i++)
-		VTEST_CHECK_RESULT(v2xSe_deleteBaEccPrivateKey(i, &statusCode),
-								V2XSE_SUCCESS);
+	*firstMs = nsFirst / (float)groupSlots / 1000000;
+	*lastMs = nsLast / (float)groupSlots / 1000000;
+	return retVal;
+}
 
-	/* Calculate elapsed time and key create time */
-	nsTimeDiff = (endTime.tv_sec - startTime.tv_sec) * 1000000000;
-	nsTimeDiff += endTime.tv_nsec;
-	nsTimeDiff -= startTime.tv_nsec;
-	VTEST_LOG("Elapsed time for %d keys: %ld ns\n", KEY_SPEED_CREATE_NUM,
-								nsTimeDiff);
-	keySpeedMs = nsTimeDiff / (float)KEY_SPEED_CREATE_NUM / (float)1000000;
-	VTEST_LOG("Key creation time: %.2f ms\n", keySpeedMs);
+/**
+ * @brief   Compare a latency percentile to a threshold
+ *
+ * @param hist histogram of measured latencies
+ * @param name name of measured operation for log messages
+ * @param thresholdMs latency requirement, in ms
+ *
+ */
+static void checkKeySpeed(vtestHist_t *hist, char *name, float thresholdMs)
+{
+	float latencyMs;
+
+	vtestHistLog(hist, name);
+	latencyMs = vtestHistPercentile(hist, KEY_SPEED_CHECK_PERCENTILE) /
+								(float)1000000;
+	VTEST_LOG("%s p%.1f latency: %.2f ms (expect %.2f ms)\n", name,
+			KEY_SPEED_CHECK_PERCENTILE, latencyMs, thresholdMs);
+	VTEST_CHECK_RESULT(latencyMs > thresholdMs, 0);
+}
+
+/**
+ * @brief   Measure speed of key creation for all key types of a key class
+ *
+ * For each key type, keys are created in all slots of the key class, then
+ * deleted.  Creation and deletion latencies of all passes of a key type
+ * are compared to thresholds.
+ * For the first key type, slots are filled a second time in descending
+ * order: if creation time depends on the slot index, the trend between
+ * first and last keys reverses, if it depends on the number of occupied
+ * slots, it is the same in both orders.
+ *
+ * @param keyClass KEY_CLASS_RT or KEY_CLASS_BA
+ *
+ */
+static void keyCreationSpeed(int keyClass)
+{
+	TypeSW_t statusCode;
+	TypeInformation_t seInfo;
+	TypeKeySpeedType_t *type;
+	char name[64];
+	char *className = (keyClass == KEY_CLASS_RT) ? "Rt" : "Ba";
+	float firstMs, lastMs;
+	int numSlots;
+	int hasV2xHw;
+	int descending;
+	int t;
+
+#if LEGACY_SECO_LIBS
+	hasV2xHw = seco_os_abs_has_v2x_hw();
+#else
+	hasV2xHw = plat_os_abs_has_v2x_hw();
+#endif
+
+	for (t = 0; t < KEY_SPEED_NUM_TYPES; t++) {
+		type = &keySpeedTypes[t];
+		if ((type->isSymmetric && (keyClass == KEY_CLASS_BA)) ||
+				(type->needsV2xHw && !hasV2xHw))
+			continue;
+
+		/* Move to ACTIVATED state, normal operating mode */
+		VTEST_CHECK_RESULT(setupActivatedNormalState(type->applet),
+								VTEST_PASS);
+		/* Get SE info, to fill all key slots of the class */
+		VTEST_CHECK_RESULT(v2xSe_getSeInfo(&statusCode, &seInfo),
+								V2XSE_SUCCESS);
+		numSlots = (keyClass == KEY_CLASS_RT) ?
+			seInfo.maxRtKeysAllowed : seInfo.maxBaKeysAllowed;
+
+		vtestHistReset(&keyCreateHist);
+		vtestHistReset(&keyDeleteHist);
+		for (descending = 0; descending <= (t == 0); descending++) {
+			if (measureKeyCreation(keyClass, type, numSlots,
+				descending, &firstMs, &lastMs) != VTEST_PASS) {
+				VTEST_FLAG_CONF();
+				goto exit;
+			}
+			VTEST_LOG("%s %s keys in %d slots, filled %s: mean"
+				" %.2f ms for first keys created, %.2f ms for"
+				" last\n", className, type->name, numSlots,
+				descending ? "from max slot" : "from slot 0",
+				firstMs, lastMs);
+		}
+
+		snprintf(name, sizeof(name), "%s %s key creation", className,
+								type->name);
+		checkKeySpeed(&keyCreateHist, name,
+				(keyClass == KEY_CLASS_RT) ?
+				KEY_SPEED_RT_CREATE_THRESHOLD :
+				KEY_SPEED_BA_CREATE_THRESHOLD);
+		snprintf(name, sizeof(name), "%s %s key deletion", className,
+								type->name);
+		checkKeySpeed(&keyDeleteHist, name,
+						KEY_SPEED_DELETE_THRESHOLD);
+	}
 
+exit:
 /* Go back to init to leave system in known state after test */
 	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
 
-	/* Need to define pass/fail criteria */
-	VTEST_FLAG_CONF();
+/**
+ *
+ * @brief Test speed of run time key creation
+ *
+ * This function tests the speed of run time key creation and deletion,
+ * for all curves and SM4 symmetric keys, filling all Rt key slots.
+ *
+ */
+void test_rtKeyCreationSpeed(void)
+{
+	keyCreationSpeed(KEY_CLASS_RT);
+}
+
+/**
+ *
+ * @brief Test speed of base key creation
+ *
+ * This function tests the speed of base key creation and deletion, for all
+ * curves, filling all Ba key slots.
+ *
+ */
+void test_baKeyCreationSpeed(void)
+{
+	keyCreationSpeed(KEY_CLASS_BA);
 }
@@ -42,32 +42,99 @@
  */
 
 #include <time.h>
+#include <limits.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
+#include <semaphore.h>
 #include <v2xSe.h>
 #include "vtest.h"
 #include "SEmisc.h"
 #include "SEperformance.h"
 #include "ecdsa.h"
 #include "vtest_async.h"
+#include "vtest_hist.h"
+
+/** Return value of memcmp for identical buffers */
+#define MEMCMP_IDENTICAL	0
 
 #ifndef MIN
 /** Compute the minimum value of two numbers */
 #define MIN(a, b) ((a) > (b) ? (b) : (a))
 #endif
 
-static volatile int count_async = ASYNC_COUNT_RESET;
+#ifndef MAX
+/** Compute the maximum value of two numbers */
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+static vtestAsync_t count_async = VTEST_ASYNC_INITIALIZER;
 static volatile int loopCount;
+/* Protects loopCount & loopsPending when several requests are in flight */
+static pthread_mutex_t loopLock = PTHREAD_MUTEX_INITIALIZER;
+static long loopsPending;
 
 static struct timespec startTime, endTime;
-static long nsMinLatency, nsMaxLatency;
+/** Latencies measured by the latency tests, in ns */
+static vtestHist_t latencyHist;
 
 static TypePublicKey_t *pubKeyArray;
 static TypePlainTextMsg_t *msgArray;
 static TypeHash_t *hashArray;
 static TypeSignature_t *sigArray;
 
+/** Parameters of a curve measured by the curve matrix tests */
+typedef struct {
+	/** Curve name for log messages */
+	char *name;
+	/** Curve id for v2xSe API */
+	TypeCurveId_t seCurveId;
+	/** Curve id for ecdsa API */
+	ecdsa_curveid_t eccCurveId;
+	/** Applet supporting the curve */
+	appletSelection_t applet;
+	/** Size of public key coordinates, in bytes */
+	int keySize;
+	/** Set if the curve is only supported with V2X HW */
+	int needsV2xHw;
+	/** Set if public key reconstruction is supported on the curve */
+	int hasReconstruction;
+} TypePerfCurve_t;
+
+/** Curves measured by the curve matrix tests */
+static TypePerfCurve_t perfCurves[PERF_NUM_CURVES] = {
+	{"NISTP256", V2XSE_CURVE_NISTP256, ECDSA_CURVE_NISTP256, e_EU,
+					V2XSE_256_EC_PUB_KEY_XY_SIZE, 0, 1},
+	{"BP256R1", V2XSE_CURVE_BP256R1, ECDSA_CURVE_BP256R1, e_EU,
+					V2XSE_256_EC_PUB_KEY_XY_SIZE, 0, 1},
+	{"BP256T1", V2XSE_CURVE_BP256T1, ECDSA_CURVE_BP256T1, e_EU,
+					V2XSE_256_EC_PUB_KEY_XY_SIZE, 1, 1},
+	{"BP384R1", V2XSE_CURVE_BP384R1, ECDSA_CURVE_BP384R1, e_EU,
+					V2XSE_384_EC_PUB_KEY_XY_SIZE, 0, 0},
+	{"BP384T1", V2XSE_CURVE_BP384T1, ECDSA_CURVE_BP384T1, e_EU,
+					V2XSE_384_EC_PUB_KEY_XY_SIZE, 1, 0},
+	{"SM2P256", V2XSE_CURVE_SM2_256, ECDSA_CURVE_SM2P256, e_CN,
+					V2XSE_256_EC_PUB_KEY_XY_SIZE, 1, 0}
+};
+/** Curve used for keys by populateTestData, NIST P256 unless changed */
+static TypePerfCurve_t *perfCurve = &perfCurves[0];
+/** Set for verification rate tests to verify hashes on perfCurve */
+static int verifOfHash;
+/** Messages of the message size sweep, replace msgArray if set */
+static uint8_t *sweepMsgData;
+/** Size of each message of the message size sweep */
+static size_t sweepMsgSize;
+/** Set for verification rate tests to use compressed keys, DECOMP_MODE_* */
+static int decompMode;
+/** Set for verification rate tests to reconstruct keys instead */
+static int reconMode;
+/** Set for verification rate tests to validate certificate chains */
+static int chainMode;
+/** Compressed y of the test keys: first byte is the LSB of y */
+static uint8_t decompPubKeyY[NUM_KEYS_PERF_TESTS]
+					[V2XSE_384_EC_PUB_KEY_XY_SIZE];
+
 static ecdsa_pubkey_t verif_pubkey;
 static uint8_t *verif_msg;
 static size_t verif_msgLen;
@@ -150,6 +217,36 @@ static uint8_t cannedSigNIST256_S[V2XSE_256_EC_S_SIGN] = {
 #endif
 };
 
+/**
+ * @brief   Fill a buffer with random data
+ *
+ * The start of the buffer is filled by the SE random number generator,
+ * which also seeds a PRNG for the rest of the buffer: the SE RNG is
+ * limited to V2XSE_MAX_RND_NUM_SIZE bytes per call, and too slow for
+ * large messages.
+ *
+ * @param data buffer to fill
+ * @param len length of buffer
+ *
+ * @return VTEST_PASS or VTEST_FAIL
+ *
+ */
+static int fillRandomData(uint8_t *data, size_t len)
+{
+	TypeSW_t hsmStatusCode;
+	unsigned int seed = 0;
+	size_t i;
+
+	if (v2xSe_getRandomNumber(MIN(V2XSE_MAX_RND_NUM_SIZE, len),
+			&hsmStatusCode, (TypeRandomNumber_t *)data))
+		return VTEST_FAIL;
+
+	memcpy(&seed, data, MIN(sizeof(seed), len));
+	for (i = V2XSE_MAX_RND_NUM_SIZE; i < len; i++)
+		data[i] = rand_r(&seed) >> 8;
+	return VTEST_PASS;
+}
+
 /**
  * @brief   Create an array of msg values for signature verification
  *
@@ -160,23 +257,17 @@ static uint8_t cannedSigNIST256_S[V2XSE_256_EC_S_SIGN] = {
  */
 static TypePlainTextMsg_t *createMsgArray(uint32_t numMsg)
 {
-	uint32_t i;
-	TypeSW_t hsmStatusCode;
 	TypePlainTextMsg_t *msgArray;
 
-	/* Generate random messages to hash */
+	/* Generate random messages to hash, in one go to limit SE calls */
 	msgArray = calloc(numMsg, sizeof(TypePlainTextMsg_t));
 	if (!msgArray)
 		return NULL;
 
-	for (i = 0; i < numMsg; i++) {
-		if (v2xSe_getRandomNumber(MIN(V2XSE_MAX_RND_NUM_SIZE,
-				sizeof(TypePlainTextMsg_t)), &hsmStatusCode,
-				(TypeRandomNumber_t *)msgArray[i].data)) {
-			free(msgArray);
-			msgArray = NULL;
-			return NULL;
-		}
+	if (fillRandomData((uint8_t *)msgArray,
+				numMsg * sizeof(TypePlainTextMsg_t))) {
+		free(msgArray);
+		return NULL;
 	}
 	return msgArray;
 }
@@ -193,7 +284,6 @@ static TypePlainTextMsg_t *createMsgArray(uint32_t numMsg)
 static TypeHash_t *createHashArray(uint32_t numHash, TypePlainTextMsg_t *msgArray)
 {
 	uint32_t i;
-	TypeSW_t hsmStatusCode;
 	TypeHash_t *hashArray;
 
 	hashArray = calloc(numHash, sizeof(TypeHash_t));
@@ -201,13 +291,11 @@ static TypeHash_t *createHashArray(uint32_t numHash, TypePlainTextMsg_t *msgArra
 		return NULL;
 
 	if (!msgArray) {
-		/* Generate random hashes to sign */
-		for (i = 0; i < numHash; i++) {
-			if (v2xSe_getRandomNumber(sizeof(TypeHash_t), &hsmStatusCode,
-					(TypeRandomNumber_t *)hashArray[i].data)) {
-				free(hashArray);
-				return NULL;
-			}
+		/* Generate random hashes to sign, in one go to limit SE calls */
+		if (fillRandomData((uint8_t *)hashArray,
+					numHash * sizeof(TypeHash_t))) {
+			free(hashArray);
+			return NULL;
 		}
 	} else {
 		/* Compute hash value from message */
@@ -404,16 +492,17 @@ static uint32_t populateTestData(uint32_t testType)
 	uint32_t retVal = VTEST_PASS;
 	uint32_t numElements;
 
-	VTEST_CHECK_RESULT(testType > TEST_TYPE_SIG_GEN_LATENCY, 0);
-	if (testType > TEST_TYPE_SIG_GEN_LATENCY)
+	VTEST_CHECK_RESULT(testType > TEST_TYPE_SIG_VERIF_CURVE, 0);
+	if (testType > TEST_TYPE_SIG_VERIF_CURVE)
 		goto fail;
 
 	/* Move to ACTIVATED state, normal operating mode for SE functions */
-	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+	VTEST_CHECK_RESULT(setupActivatedNormalState(perfCurve->applet),
+								VTEST_PASS);
 
 	/* Generate keys to sign with - all tests need this */
 	pubKeyArray = createPubKeyArray(NUM_KEYS_PERF_TESTS,
-							V2XSE_CURVE_NISTP256);
+							perfCurve->seCurveId);
 	VTEST_CHECK_RESULT((!pubKeyArray), 0);
 	if (!pubKeyArray)
 		goto fail;
@@ -432,6 +521,9 @@ static uint32_t populateTestData(uint32_t testType)
 	case TEST_TYPE_SIG_GEN_LATENCY:
 		numElements = SIG_LATENCY_GEN_NUM;
 		break;
+	case TEST_TYPE_SIG_VERIF_CURVE:
+		numElements = SIG_CURVE_VERIF_NUM;
+		break;
 	default:
 		goto fail_num;
 	}
@@ -498,22 +590,133 @@ exit:
  */
 static void freeTestData(uint32_t testType)
 {
-	if (testType <= TEST_TYPE_SIG_GEN_LATENCY) {
+	if (testType <= TEST_TYPE_SIG_VERIF_CURVE) {
 		free(pubKeyArray);
 		free(hashArray);
 	}
 	if ((testType == TEST_TYPE_SIG_VERIF_RATE) ||
-			(testType == TEST_TYPE_SIG_VERIF_LATENCY)) {
+			(testType == TEST_TYPE_SIG_VERIF_LATENCY) ||
+			(testType == TEST_TYPE_SIG_VERIF_CURVE)) {
 		free(sigArray);
 		free(msgArray);
 		msgArray = NULL;
 	}
 }
 
+static void signatureVerificationCallback_rate(void *sequence_number,
+	int ret,
+	ecdsa_verification_result_t verification_result);
+static void launchDecompRate(int loop);
+static void launchReconRate(int loop);
+static void launchChain(int loop);
+
+/**
+ * @brief   Get number of next message to verify in verification rate test
+ *
+ * @return message number, counting down to 1, or 0 if all are launched
+ *
+ */
+static int nextSigVerifRateLoop(void)
+{
+	int loop = 0;
+
+	pthread_mutex_lock(&loopLock);
+	if (loopCount > 0)
+		loop = loopCount--;
+	pthread_mutex_unlock(&loopLock);
+
+	return loop;
+}
+
+/**
+ * @brief   Launch one signature verification of the verification rate test
+ *
+ * Only local pointers are used, as this can be called from the test and
+ * from the callback at the same time when several verifications are in
+ * flight.
+ *
+ * @param loop number of the message to verify, as from nextSigVerifRateLoop
+ *
+ */
+static void launchSigVerifRate(int loop)
+{
+	ecdsa_pubkey_t pubkey;
+	ecdsa_sig_t sig;
+
+	pubkey.x = pubKeyArray[(loop - 1) % NUM_KEYS_PERF_TESTS].x;
+	pubkey.y = pubKeyArray[(loop - 1) % NUM_KEYS_PERF_TESTS].y;
+	sig.r = sigArray[loop - 1].r;
+	sig.s = sigArray[loop - 1].s;
+	if (decompMode) {
+		launchDecompRate(loop);
+		return;
+	}
+	if (reconMode) {
+		launchReconRate(loop);
+		return;
+	}
+	if (chainMode) {
+		launchChain(loop);
+		return;
+	}
+	if (verifOfHash) {
+		VTEST_CHECK_RESULT_ASYNC_INC(
+			ecdsa_verify_signature(perfCurve->eccCurveId, pubkey,
+				(ecdsa_hash_t)hashArray[loop - 1].data, sig, 0,
+				signatureVerificationCallback_rate,
+				REQ_VERIF_PASS(&count_async,
+					ASYNC_OP_VERIF_HASH)),
+			ECDSA_NO_ERROR, count_async);
+		return;
+	}
+	if (sweepMsgData) {
+		VTEST_CHECK_RESULT_ASYNC_INC(
+			ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
+				pubkey, sweepMsgData + (loop - 1) * sweepMsgSize,
+				sweepMsgSize, sig, 0,
+				signatureVerificationCallback_rate,
+				REQ_VERIF_PASS(&count_async,
+					ASYNC_OP_VERIF_MSG)),
+			ECDSA_NO_ERROR, count_async);
+		return;
+	}
+	VTEST_CHECK_RESULT_ASYNC_INC(
+		ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
+			pubkey, msgArray[loop - 1].data,
+			sizeof(msgArray[loop - 1].data), sig, 0,
+			signatureVerificationCallback_rate,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_MSG)),
+		ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief   End one loop of the verification rate test
+ *
+ * Logs the end time after the last loop, and launches the next loop if
+ * any are left.  Called from the callback ending each loop.
+ *
+ */
+static void endSigVerifRateLoop(void)
+{
+	int loop;
+
+	/* Log end time on last verification, before releasing the test */
+	pthread_mutex_lock(&loopLock);
+	if ((--loopsPending == 0) &&
+			(clock_gettime(CLOCK_BOOTTIME, &endTime) == -1))
+		VTEST_FLAG_CONF();
+	pthread_mutex_unlock(&loopLock);
+
+	/* Launch next loop, if any left */
+	loop = nextSigVerifRateLoop();
+	if (loop)
+		launchSigVerifRate(loop);
+}
+
 /**
  * @brief   Signature verification callback: rate tests
  *
- * @param[in]  sequence_number       sequence operation id (not used?)
+ * @param[in]  sequence_number       request slot of the operation
  * @param[out] ret                   returned value by the dispatcher
  * @param[out] verification_result   verification result
  *
@@ -522,79 +725,262 @@ static void signatureVerificationCallback_rate(void *sequence_number,
 	int ret,
 	ecdsa_verification_result_t verification_result)
 {
+	vtestAsyncReq_t req;
+
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
+	vtestHistRecord(&latencyHist, req.nsLatency);
+
+	endSigVerifRateLoop();
 	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
-	if (--loopCount > 0) {
-		/* Setup ECDSA pointers for next loop */
-		SETUP_ECDSA_SIG_VERIF_PTRS(loopCount);
-		/* Launch next loop */
-		VTEST_CHECK_RESULT_ASYNC_INC(
-			ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
-				verif_pubkey, verif_msg, verif_msgLen, verif_sig, 0,
-				signatureVerificationCallback_rate,
-				(void *)0),
-			ECDSA_NO_ERROR, count_async);
-	} else {
-		/* Log end time */
-		if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
-			VTEST_FLAG_CONF();
+}
+
+/**
+ * @brief   Check a decompressed public key of the decompression tests
+ *
+ * @param pubKey decompressed public key
+ * @param loop number of the loop that decompressed the key
+ *
+ */
+static void checkDecompPubKey(ecdsa_pubkey_t *pubKey, int loop)
+{
+	VTEST_CHECK_RESULT(!pubKey, 0);
+	if (pubKey)
+		VTEST_CHECK_RESULT(memcmp(pubKey->y,
+			pubKeyArray[(loop - 1) % NUM_KEYS_PERF_TESTS].y,
+			perfCurve->keySize), MEMCMP_IDENTICAL);
+}
+
+/**
+ * @brief   Public key decompression callback: rate tests
+ *
+ * In DECOMP_MODE_DECOMP_THEN_VERIF, launches the verification of the
+ * loop, which ends the loop; its latency includes the decompression.
+ *
+ * @param[in]  sequence_number       request slot of the operation
+ * @param[out] ret                   returned value by the dispatcher
+ * @param[out] pubKey_decompressed   decompressed public key
+ *
+ */
+static void decompressionCallback_rate(void *sequence_number,
+	int ret,
+	ecdsa_pubkey_t *pubKey_decompressed)
+{
+	vtestAsyncReq_t req;
+	ecdsa_pubkey_t pubkey;
+	ecdsa_sig_t sig;
+	int loop;
+	int key;
+	int status;
+
+	status = vtestAsyncReqComplete(&count_async, sequence_number, &req);
+	VTEST_CHECK_RESULT(status, VTEST_PASS);
+	if (status == VTEST_PASS) {
+		loop = req.owner;
+		key = (loop - 1) % NUM_KEYS_PERF_TESTS;
+		checkDecompPubKey(pubKey_decompressed, loop);
+		if (decompMode == DECOMP_MODE_DECOMP_THEN_VERIF) {
+			/*
+			 * Verify with the test key, checked identical to the
+			 * decompressed one, which is only valid in the callback
+			 */
+			pubkey.x = pubKeyArray[key].x;
+			pubkey.y = pubKeyArray[key].y;
+			sig.r = sigArray[loop - 1].r;
+			sig.s = sigArray[loop - 1].s;
+			VTEST_CHECK_RESULT_ASYNC_INC(
+				ecdsa_verify_signature(perfCurve->eccCurveId,
+					pubkey,
+					(ecdsa_hash_t)hashArray[loop - 1].data,
+					sig, 0, signatureVerificationCallback_rate,
+					vtestAsyncReqIssueAt(&count_async,
+						ASYNC_OP_VERIF_HASH,
+						ECDSA_VERIFICATION_SUCCESS,
+						&req.issueTime)),
+				ECDSA_NO_ERROR, count_async);
+			VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR,
+								count_async);
 			return;
 		}
+		vtestHistRecord(&latencyHist, req.nsLatency);
 	}
+
+	endSigVerifRateLoop();
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
- * @brief   Signature verification callback: latency tests
+ * @brief   Decompress and verify callback: rate tests
  *
- * @param[in]  sequence_number       sequence operation id (not used?)
+ * @param[in]  sequence_number       request slot of the operation
  * @param[out] ret                   returned value by the dispatcher
+ * @param[out] pubKey_decompressed   decompressed public key
  * @param[out] verification_result   verification result
  *
  */
-static void signatureVerificationCallback_latency(void *sequence_number,
+static void decompVerifCallback_rate(void *sequence_number,
 	int ret,
+	ecdsa_pubkey_t *pubKey_decompressed,
 	ecdsa_verification_result_t verification_result)
 {
-	long nsLatency;
+	vtestAsyncReq_t req;
+	int status;
+
+	status = vtestAsyncReqComplete(&count_async, sequence_number, &req);
+	VTEST_CHECK_RESULT(status, VTEST_PASS);
+	if (status == VTEST_PASS) {
+		VTEST_CHECK_RESULT(verification_result, req.expResult);
+		checkDecompPubKey(pubKey_decompressed, req.owner);
+		vtestHistRecord(&latencyHist, req.nsLatency);
+	}
 
-	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
-		VTEST_FLAG_CONF();
+	endSigVerifRateLoop();
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief   Launch one loop of the public key decompression rate test
+ *
+ * The compressed test key of the loop is decompressed alone, or with the
+ * verification of the loop signature, depending on decompMode.
+ *
+ * @param loop number of the message to verify, as from nextSigVerifRateLoop
+ *
+ */
+static void launchDecompRate(int loop)
+{
+	ecdsa_compressed_pubkey_t compPubkey;
+	ecdsa_pubkey_t pubkey;
+	vtestAsyncReq_t *req;
+	ecdsa_sig_t sig;
+
+	if (decompMode == DECOMP_MODE_FUSED) {
+		compPubkey.x = pubKeyArray[(loop - 1) % NUM_KEYS_PERF_TESTS].x;
+		compPubkey.y = decompPubKeyY[(loop - 1) % NUM_KEYS_PERF_TESTS];
+		req = REQ_VERIF_PASS(&count_async, ASYNC_OP_DECOMP_VERIF_HASH);
+		if (req)
+			req->owner = loop;
+		sig.r = sigArray[loop - 1].r;
+		sig.s = sigArray[loop - 1].s;
+		VTEST_CHECK_RESULT_ASYNC_INC(
+			ecdsa_decompress_and_verify_signature(
+				perfCurve->eccCurveId, compPubkey,
+				(ecdsa_hash_t)hashArray[loop - 1].data, sig, 0,
+				decompVerifCallback_rate, req),
+			ECDSA_NO_ERROR, count_async);
 		return;
 	}
+	pubkey.x = pubKeyArray[(loop - 1) % NUM_KEYS_PERF_TESTS].x;
+	pubkey.y = decompPubKeyY[(loop - 1) % NUM_KEYS_PERF_TESTS];
+	req = vtestAsyncReqIssue(&count_async, ASYNC_OP_DECOMP, ECDSA_NO_ERROR);
+	if (req)
+		req->owner = loop;
+	VTEST_CHECK_RESULT_ASYNC_INC(
+		ecdsa_decompress_public_key(perfCurve->eccCurveId, pubkey, 0,
+			decompressionCallback_rate, req),
+		ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief   Public key reconstruction callback: rate tests
+ *
+ * @param[in]  sequence_number           request slot of the operation
+ * @param[out] ret                       returned value by the dispatcher
+ * @param[out] reconstructed_public_key  reconstructed public key
+ *
+ */
+static void reconstructionCallback_rate(void *sequence_number,
+	int ret,
+	ecdsa_pubkey_t *reconstructed_public_key)
+{
+	vtestAsyncReq_t req;
+	int status;
+
+	status = vtestAsyncReqComplete(&count_async, sequence_number, &req);
+	VTEST_CHECK_RESULT(status, VTEST_PASS);
+	if (status == VTEST_PASS) {
+		VTEST_CHECK_RESULT(!reconstructed_public_key, 0);
+		vtestHistRecord(&latencyHist, req.nsLatency);
+	}
 
+	endSigVerifRateLoop();
 	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
+}
+
+/**
+ * @brief   Launch one loop of the public key reconstruction rate test
+ *
+ * The inputs of each loop are distinct: the hash of the loop is used as
+ * certificate hash, and pairs of test keys are used as reconstruction
+ * data and CA public key, so that every combination is used.
+ *
+ * @param loop number of the hash to use, as from nextSigVerifRateLoop
+ *
+ */
+static void launchReconRate(int loop)
+{
+	ecdsa_point_t recData;
+	ecdsa_point_t caPubKey;
+	int recKey;
+	int caKey;
+
+	recKey = (loop - 1) % NUM_KEYS_PERF_TESTS;
+	caKey = ((loop - 1) / NUM_KEYS_PERF_TESTS) % NUM_KEYS_PERF_TESTS;
+	recData.x = pubKeyArray[recKey].x;
+	recData.y = pubKeyArray[recKey].y;
+	caPubKey.x = pubKeyArray[caKey].x;
+	caPubKey.y = pubKeyArray[caKey].y;
+	VTEST_CHECK_RESULT_ASYNC_INC(
+		ecdsa_reconstruct_public_key(perfCurve->eccCurveId,
+			(ecdsa_hash_t)hashArray[loop - 1].data, recData,
+			caPubKey, 0, reconstructionCallback_rate,
+			vtestAsyncReqIssue(&count_async, ASYNC_OP_RECONSTRUCT,
+							ECDSA_NO_ERROR)),
+		ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief   Signature verification callback: latency tests
+ *
+ * @param[in]  sequence_number       request slot of the operation
+ * @param[out] ret                   returned value by the dispatcher
+ * @param[out] verification_result   verification result
+ *
+ */
+static void signatureVerificationCallback_latency(void *sequence_number,
+	int ret,
+	ecdsa_verification_result_t verification_result)
+{
+	vtestAsyncReq_t req;
 
-	/* Calculate latency */
-	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsLatency);
+	/* Latency is measured from issue time stored in the request slot */
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 
-	/* Update max/min if required */
-	if (nsLatency > nsMaxLatency)
-		nsMaxLatency = nsLatency;
-	if (nsLatency < nsMinLatency)
-		nsMinLatency = nsLatency;
+	vtestHistRecord(&latencyHist, req.nsLatency);
 
 	/* Start next loop if required */
 	if (--loopCount > 0) {
 		/* Setup ECDSA pointers for next loop */
 		SETUP_ECDSA_SIG_VERIF_PTRS(loopCount);
 		/* Launch next loop */
-		if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
-			VTEST_FLAG_CONF();
-			return;
-		}
 		VTEST_CHECK_RESULT_ASYNC_INC(
 			ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
 				verif_pubkey, verif_msg, verif_msgLen, verif_sig, 0,
-				signatureVerificationCallback_latency, (void *)0),
+				signatureVerificationCallback_latency,
+				REQ_VERIF_PASS(&count_async,
+					ASYNC_OP_VERIF_MSG)),
 			ECDSA_NO_ERROR, count_async);
 	}
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
  * @brief   Signature verification callback: background (no measurement)
  *
- * @param[in]  sequence_number       sequence operation id (not used?)
+ * @param[in]  sequence_number       request slot of the operation
  * @param[out] ret                   returned value by the dispatcher
  * @param[out] verification_result   verification result
  *
@@ -603,81 +989,123 @@ static void signatureVerificationCallback_background(void *sequence_number,
 	int ret,
 	ecdsa_verification_result_t verification_result)
 {
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
+	vtestAsyncReq_t req;
+
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 	if (--loopCount > 0) {
 		/* Launch next loop */
 		VTEST_CHECK_RESULT_ASYNC_INC(
 			ecdsa_verify_signature(ECDSA_CURVE_NISTP256, verif_pubkey,
 				verif_hash, verif_sig, 0,
 				signatureVerificationCallback_background,
-				(void *)0),
+				REQ_VERIF_PASS(&count_async,
+					ASYNC_OP_VERIF_HASH)),
 			ECDSA_NO_ERROR, count_async);
 	}
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
+ * @brief   Get signature verification rate pass/fail threshold
  *
- * @brief Test rate of signature verification
- *
- * This function tests the rate of signature verification
+ * @return threshold in verifs/sec for the HSM in use
  *
  */
-void test_sigVerifRate(void)
+static long sigVerifRateThreshold(void)
 {
-	long nsTimeDiff;
-	long sigVerifRate;
-	long threshold;
-
 #if LEGACY_SECO_LIBS
 	if (seco_os_abs_has_v2x_hw())
 #else
 	if (plat_os_abs_has_v2x_hw())
 #endif
-		threshold = SIG_VERIF_RATE_THRESHOLD_V2XFW;
+		return SIG_VERIF_RATE_THRESHOLD_V2XFW;
 	else
-		threshold = SIG_VERIF_RATE_THRESHOLD_SECOFW;
-
-	/* Populate data for test */
-	if (populateTestData(TEST_TYPE_SIG_VERIF_RATE))
-		return;
+		return SIG_VERIF_RATE_THRESHOLD_SECOFW;
+}
 
-	/* Set up system for signature verification */
-	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
-	loopCount = SIG_RATE_VERIF_NUM;
+/**
+ * @brief   Measure rate of signature verification
+ *
+ * Verifies the first numVerifs signatures of the test data, keeping
+ * depth verifications in flight: each callback launches the next
+ * verification until all have been launched.  The latency of each
+ * verification is recorded in latencyHist.  Test data must be populated
+ * and ecdsa opened before calling.
+ *
+ * @param depth number of verifications kept in flight
+ * @param numVerifs number of verifications to perform
+ *
+ * @return verification rate in verifs/sec, or 0 on failure
+ *
+ */
+static long measureSigVerifRate(int depth, long numVerifs)
+{
+	long nsTimeDiff;
+	int loop;
+	int i;
 
-	/* Setup ECDSA variables to point to first data to verify */
-	SETUP_ECDSA_SIG_VERIF_PTRS(loopCount);
+	loopCount = numVerifs;
+	loopsPending = numVerifs;
+	vtestHistReset(&latencyHist);
 
 	/* Log start time */
 	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
 		VTEST_FLAG_CONF();
-		/* Free allocated data */
-		freeTestData(TEST_TYPE_SIG_VERIF_RATE);
-		return;
+		return 0;
 	}
 
 	/* Start verification loops */
-	VTEST_CHECK_RESULT_ASYNC_INC(
-		ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
-			verif_pubkey, verif_msg, verif_msgLen, verif_sig, 0,
-			signatureVerificationCallback_rate, (void *)0),
-		ECDSA_NO_ERROR, count_async);
+	for (i = 0; i < depth; i++) {
+		loop = nextSigVerifRateLoop();
+		if (loop)
+			launchSigVerifRate(loop);
+	}
 	/* Wait for end of loop */
 	VTEST_CHECK_RESULT_ASYNC_LOOP(count_async, loopCount);
+
+	/* Check test finished as expected */
+	if (loopCount || loopsPending)
+		return 0;
+
+	/* Calculate elapsed time and sign verif rate */
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	VTEST_LOG("Elapsed time for %ld signature verifications (%d in flight):"
+		" %ld ms\n", numVerifs, depth, nsTimeDiff/1000000);
+	return numVerifs * 1000000000 / nsTimeDiff;
+}
+
+/**
+ *
+ * @brief Test rate of signature verification
+ *
+ * This function tests the rate of signature verification, with
+ * SIG_VERIF_RATE_DEPTH verifications in flight
+ *
+ */
+void test_sigVerifRate(void)
+{
+	long sigVerifRate;
+	long threshold;
+
+	threshold = sigVerifRateThreshold();
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_VERIF_RATE))
+		return;
+
+	/* Set up system for signature verification */
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+	sigVerifRate = measureSigVerifRate(SIG_VERIF_RATE_DEPTH,
+							SIG_RATE_VERIF_NUM);
 	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
 
 	/* If test finished as expected */
-	if (!loopCount) {
-		/* Calculate elapsed time and sign verif rate */
-		CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
-		VTEST_LOG("Elapsed time for %d signature verifications:"
-			" %ld ms\n", SIG_RATE_VERIF_NUM, nsTimeDiff/1000000);
-		sigVerifRate = SIG_RATE_VERIF_NUM * 1000000000 / nsTimeDiff;
+	if (sigVerifRate) {
 		VTEST_LOG("Signature verification rate: %ld verifs/sec"
-			" (expect %d)\n", sigVerifRate,
+			" (expect %ld)\n", sigVerifRate,
 			threshold);
-
 		/* Compare to requirement */
 		VTEST_CHECK_RESULT(sigVerifRate < threshold, 0);
 	}
@@ -688,569 +1116,4528 @@ void test_sigVerifRate(void)
 
 /**
  *
- * @brief Test rate of signature generation
+ * @brief Test rate of signature verification versus in flight depth
  *
- * This function tests the rate of signature generation
+ * This function measures the rate of signature verification with 1, 2,
+ * 4... verifications in flight, up to 2^(SIG_VERIF_DEPTH_STEPS - 1).  The
+ * depth where the rate saturates, i.e. the lowest depth reaching the max
+ * rate within SIG_VERIF_DEPTH_SATURATION_PCT, is reported.  The max rate is
+ * compared to the signature verification rate requirement.
  *
  */
-void test_sigGenRate(void)
+void test_sigVerifRateDepth(void)
 {
-	TypeSW_t statusCode;
-	TypeSignature_t signature;
-	int i;
-	long nsTimeDiff;
-	long sigGenRate;
+	long sigVerifRate[SIG_VERIF_DEPTH_STEPS];
+	long maxRate = 0;
+	long threshold;
+	int numSteps;
+	int step;
+
+	threshold = sigVerifRateThreshold();
 
 	/* Populate data for test */
-	if (populateTestData(TEST_TYPE_SIG_GEN_RATE))
+	if (populateTestData(TEST_TYPE_SIG_VERIF_RATE))
 		return;
 
-	/* Move to ACTIVATED state, normal operating mode */
-	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+	/* Set up system for signature verification */
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
 
-	/* Log start time */
-	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
-		VTEST_FLAG_CONF();
-		freeTestData(TEST_TYPE_SIG_GEN_RATE);
-		return;
+	/* Measure rate for each depth, stop on first failure */
+	for (numSteps = 0; numSteps < SIG_VERIF_DEPTH_STEPS; numSteps++) {
+		sigVerifRate[numSteps] = measureSigVerifRate(1 << numSteps,
+							SIG_RATE_VERIF_NUM);
+		if (!sigVerifRate[numSteps])
+			break;
+		if (sigVerifRate[numSteps] > maxRate)
+			maxRate = sigVerifRate[numSteps];
 	}
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
 
-	/* Generate the signatures */
-	for (i = 0; i < SIG_RATE_GEN_NUM; i++) {
-		VTEST_CHECK_RESULT(v2xSe_createRtSign(i % NUM_KEYS_PERF_TESTS,
-				&hashArray[i],	&statusCode, &signature),
-				V2XSE_SUCCESS);
+	/* Report throughput vs depth curve and saturation point */
+	for (step = 0; step < numSteps; step++)
+		VTEST_LOG("Depth %3d: %ld verifs/sec\n", 1 << step,
+							sigVerifRate[step]);
+	for (step = 0; step < numSteps; step++) {
+		if (sigVerifRate[step] * 100 >=
+			maxRate * (100 - SIG_VERIF_DEPTH_SATURATION_PCT)) {
+			VTEST_LOG("Signature verification rate saturates at"
+				" depth %d: %ld verifs/sec (max %ld, expect %ld)\n",
+				1 << step, sigVerifRate[step], maxRate,
+				threshold);
+			break;
+		}
 	}
 
-	/* Log end time */
-	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
-		VTEST_FLAG_CONF();
-		freeTestData(TEST_TYPE_SIG_GEN_RATE);
-		return;
-	}
+	/* Compare max rate to requirement, if all depths measured */
+	if (numSteps == SIG_VERIF_DEPTH_STEPS)
+		VTEST_CHECK_RESULT(maxRate < threshold, 0);
 
 	/* Free allocated data */
-	freeTestData(TEST_TYPE_SIG_GEN_RATE);
-
-	/* Calculate elapsed time and sig gen rate */
-	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
-	VTEST_LOG("Elapsed time for %d signature generations: %ld ns\n",
-					SIG_RATE_GEN_NUM, nsTimeDiff);
-	sigGenRate = SIG_RATE_GEN_NUM * 1000000000 / nsTimeDiff;
-	VTEST_LOG("Signature generation rate: %ld sig/sec (expect %d)\n",
-					sigGenRate, SIG_GEN_RATE_THRESHOLD);
+	freeTestData(TEST_TYPE_SIG_VERIF_RATE);
+}
 
-	/* Compare to requirement */
-	VTEST_CHECK_RESULT(sigGenRate < SIG_GEN_RATE_THRESHOLD, 0);
+/** State of one signature verification submitter thread */
+typedef struct {
+	/** Thread handle */
+	pthread_t thread;
+	/** Counts verifications the thread may still put in flight */
+	sem_t depth;
+	/** Index of the thread, selects its slice of the test data */
+	int index;
+	/** Number of verifications completed for the thread */
+	long numDone;
+} TypeSubmitter_t;
+
+/** Submitter threads of the multi-threaded verification rate test */
+static TypeSubmitter_t submitters[SIG_VERIF_MAX_THREADS];
+/** Set to stop the submitter threads */
+static volatile int stopSubmitters;
 
-/* Go back to init to leave system in known state after test */
-	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+/**
+ * @brief   Signature verification callback: multi-threaded rate test
+ *
+ * @param[in]  sequence_number       request slot of the operation
+ * @param[out] ret                   returned value by the dispatcher
+ * @param[out] verification_result   verification result
+ *
+ */
+static void signatureVerificationCallback_threads(void *sequence_number,
+	int ret,
+	ecdsa_verification_result_t verification_result)
+{
+	vtestAsyncReq_t req;
+	int status;
+
+	status = vtestAsyncReqComplete(&count_async, sequence_number, &req);
+	VTEST_CHECK_RESULT(status, VTEST_PASS);
+	if (status == VTEST_PASS) {
+		VTEST_CHECK_RESULT(verification_result, req.expResult);
+		/* Credit the submitter and let it send its next verification */
+		__atomic_fetch_add(&submitters[req.owner].numDone, 1,
+							__ATOMIC_RELAXED);
+		sem_post(&submitters[req.owner].depth);
+	}
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 /**
+ * @brief   Signature verification submitter thread
  *
- * @brief Test latency of signature verification.
+ * Verifies the messages of its own slice of the test data in a loop,
+ * keeping up to SIG_VERIF_THREAD_DEPTH verifications in flight, until
+ * stopSubmitters is set.
  *
- * This function tests the latency of signature verification.  If requested,
- * simulation of a loaded system is done using constant signature generations
- * in parallel with the signature verifications.
+ * @param arg submitter state of the thread
  *
- * @param testType indicates whether test should run on loaded system or not
+ * @return NULL
  *
  */
-void test_sigVerifLatency(uint32_t testType)
+static void *sigVerifSubmitter(void *arg)
 {
-	float sigVerifMinLatencyMs;
-	float sigVerifMaxLatencyMs;
-	TypeSW_t statusCode;
-	TypePublicKey_t gen_pubKey;
-	TypeSignature_t gen_signature;
-
-	/* Populate data for test */
-	if (populateTestData(TEST_TYPE_SIG_VERIF_LATENCY))
-		return;
+	TypeSubmitter_t *sub = arg;
+	long sliceLen = SIG_RATE_VERIF_NUM / SIG_VERIF_MAX_THREADS;
+	vtestAsyncReq_t *req;
+	ecdsa_pubkey_t pubkey;
+	ecdsa_sig_t sig;
+	long i;
+	long idx;
+
+	for (i = 0; ; i++) {
+		sem_wait(&sub->depth);
+		if (stopSubmitters)
+			break;
+		req = vtestAsyncReqIssue(&count_async, ASYNC_OP_VERIF_MSG,
+						ECDSA_VERIFICATION_SUCCESS);
+		if (!req) {
+			/* Depth is bounded, no free slot means a slot leak */
+			VTEST_FLAG_CONF();
+			break;
+		}
+		req->owner = sub->index;
 
-	if (testType == LOADED_TEST) {
-		/* Move to ACTIVATED state, normal operating mode */
-		VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
-		/* Create RT key for background sig gen operations */
-		VTEST_CHECK_RESULT(v2xSe_generateRtEccKeyPair(SLOT_ZERO,
-			V2XSE_CURVE_NISTP256, &statusCode, &gen_pubKey),
-								V2XSE_SUCCESS);
+		idx = sub->index * sliceLen + i % sliceLen;
+		pubkey.x = pubKeyArray[idx % NUM_KEYS_PERF_TESTS].x;
+		pubkey.y = pubKeyArray[idx % NUM_KEYS_PERF_TESTS].y;
+		sig.r = sigArray[idx].r;
+		sig.s = sigArray[idx].s;
+		VTEST_CHECK_RESULT_ASYNC_INC(
+			ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
+				pubkey, msgArray[idx].data,
+				sizeof(msgArray[idx].data), sig, 0,
+				signatureVerificationCallback_threads, req),
+			ECDSA_NO_ERROR, count_async);
 	}
+	return NULL;
+}
 
-	/* Set up system for signature verification */
-	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
-	loopCount = SIG_LATENCY_VERIF_NUM;
-
-	/* Setup ECDSA variables to point to first data to verify */
-	SETUP_ECDSA_SIG_VERIF_PTRS(loopCount);
+/**
+ * @brief   Measure rate of signature verification from several threads
+ *
+ * Runs numThreads submitter threads for SIG_VERIF_THREADS_SECONDS.  Test
+ * data must be populated and ecdsa opened before calling.
+ *
+ * @param numThreads number of submitter threads
+ * @param numDone number of verifications completed for each thread
+ *
+ * @return aggregate verification rate in verifs/sec, or 0 on failure
+ *
+ */
+static long measureSigVerifThreads(int numThreads, long *numDone)
+{
+	long nsTimeDiff;
+	long total = 0;
+	int numStarted;
+	int i;
 
-	/* Init max & min before first measurement */
-	nsMinLatency = SIG_LATENCY_MIN_INIT;
-	nsMaxLatency = SIG_LATENCY_MAX_INIT;
-	/* Log start time */
+	stopSubmitters = 0;
 	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
 		VTEST_FLAG_CONF();
-		goto stopVerifLatencyTest;
+		return 0;
+	}
+	for (numStarted = 0; numStarted < numThreads; numStarted++) {
+		submitters[numStarted].index = numStarted;
+		submitters[numStarted].numDone = 0;
+		sem_init(&submitters[numStarted].depth, 0,
+						SIG_VERIF_THREAD_DEPTH);
+		if (pthread_create(&submitters[numStarted].thread, NULL,
+				sigVerifSubmitter, &submitters[numStarted])) {
+			sem_destroy(&submitters[numStarted].depth);
+			VTEST_FLAG_CONF();
+			break;
+		}
 	}
 
-	/* Start verification loops */
-	VTEST_CHECK_RESULT_ASYNC_INC(
-		ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
-			verif_pubkey, verif_msg, verif_msgLen, verif_sig, 0,
-			signatureVerificationCallback_latency, (void *)0),
-		ECDSA_NO_ERROR, count_async);
+	sleep(SIG_VERIF_THREADS_SECONDS);
 
-	if (testType == LOADED_TEST) {
-	/*
-	 * Run parallel signature generation until verif counter goes to 0.
-	 * Use canned hash & single key for parallel sig gen.  Performance
-	 * of sig gen operations not measured so don't care about possible
-	 * cache effects of always using same data.
-	 */
-		while (loopCount > 0) {
-			VTEST_CHECK_RESULT(v2xSe_createRtSign(SLOT_ZERO,
-				&cannedHash, &statusCode, &gen_signature),
-								V2XSE_SUCCESS);
-		}
-		/* Clean up - loops should be finished */
-		VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_1_MS);
-	} else {
-	/* Unloaded test - just wait for end */
-		VTEST_CHECK_RESULT_ASYNC_LOOP(count_async, loopCount);
+	/* Stop submitters, waking any waiting for a free in-flight slot */
+	stopSubmitters = 1;
+	for (i = 0; i < numStarted; i++) {
+		sem_post(&submitters[i].depth);
+		pthread_join(submitters[i].thread, NULL);
 	}
+	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, ASYNC_LOOP_TIMEOUT);
+	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1)
+		VTEST_FLAG_CONF();
 
-stopVerifLatencyTest:
-	/* Finished verifications */
-	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+	for (i = 0; i < numStarted; i++) {
+		sem_destroy(&submitters[i].depth);
+		numDone[i] = submitters[i].numDone;
+		total += numDone[i];
+	}
+	if (numStarted < numThreads)
+		return 0;
 
-	/* Free allocated data */
-	freeTestData(TEST_TYPE_SIG_VERIF_LATENCY);
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	return total * 1000000000 / nsTimeDiff;
+}
 
-	/* If test finished as expected */
-	if (!loopCount) {
-		/* Calculate max/min latency */
-		sigVerifMinLatencyMs = nsMinLatency / (float)1000000;
-		sigVerifMaxLatencyMs = nsMaxLatency / (float)1000000;
-		VTEST_LOG("Sig verif latency: %.2f ms min,"
-				" %.2f ms max (allow %.2f)\n",
-				sigVerifMinLatencyMs, sigVerifMaxLatencyMs,
-				SIG_VERIF_LATENCY_THRESHOLD);
+/**
+ *
+ * @brief Test rate of signature verification from several threads
+ *
+ * This function measures the aggregate rate of signature verification
+ * with 1 to SIG_VERIF_MAX_THREADS threads submitting verifications of
+ * their own data in parallel, as done by a stack receiving messages on
+ * several threads.  For each thread count, the aggregate rate and the
+ * fairness between threads (Jain's index: 1.0 when all threads complete
+ * the same number of verifications) are reported.  The max aggregate rate
+ * is compared to the signature verification rate requirement.
+ *
+ */
+void test_sigVerifRateThreads(void)
+{
+	long sigVerifRate[SIG_VERIF_MAX_THREADS];
+	long numDone[SIG_VERIF_MAX_THREADS];
+	long maxRate = 0;
+	long minDone;
+	long maxDone;
+	long threshold;
+	double sum;
+	double sumSquares;
+	int numThreads;
+	int i;
 
-		/* Compare to requirement */
-		VTEST_CHECK_RESULT(sigVerifMaxLatencyMs >
-					SIG_VERIF_LATENCY_THRESHOLD, 0);
+	threshold = sigVerifRateThreshold();
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_VERIF_RATE))
+		return;
+
+	/* Set up system for signature verification */
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+
+	/* Measure rate for each thread count, stop on first failure */
+	for (numThreads = 1; numThreads <= SIG_VERIF_MAX_THREADS;
+								numThreads++) {
+		sigVerifRate[numThreads - 1] =
+				measureSigVerifThreads(numThreads, numDone);
+		if (!sigVerifRate[numThreads - 1])
+			break;
+		if (sigVerifRate[numThreads - 1] > maxRate)
+			maxRate = sigVerifRate[numThreads - 1];
+
+		minDone = maxDone = numDone[0];
+		sum = sumSquares = 0;
+		for (i = 0; i < numThreads; i++) {
+			if (numDone[i] < minDone)
+				minDone = numDone[i];
+			if (numDone[i] > maxDone)
+				maxDone = numDone[i];
+			sum += numDone[i];
+			sumSquares += (double)numDone[i] * numDone[i];
+		}
+		VTEST_LOG("%d threads: %ld verifs/sec (x%.2f), per thread"
+			" %ld to %ld verifs, fairness %.3f\n", numThreads,
+			sigVerifRate[numThreads - 1],
+			sigVerifRate[numThreads - 1] / (float)sigVerifRate[0],
+			minDone, maxDone, sumSquares ?
+			sum * sum / (numThreads * sumSquares) : 0);
 	}
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
 
-	/* Go back to init to leave system in known state after test */
-	if (testType == LOADED_TEST) {
-		/* Delete key after use */
-		VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(SLOT_ZERO,
-						&statusCode), V2XSE_SUCCESS);
-		VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+	/* Compare max rate to requirement, if all thread counts measured */
+	if (numThreads > SIG_VERIF_MAX_THREADS) {
+		VTEST_LOG("Max signature verification rate: %ld verifs/sec"
+				" (expect %ld)\n", maxRate, threshold);
+		VTEST_CHECK_RESULT(maxRate < threshold, 0);
 	}
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_VERIF_RATE);
 }
 
 /**
  *
- * @brief Test latency of signature verification in loaded system
+ * @brief Test rate and latency of signature verification for each curve
  *
- * This function tests the latency of signature verification.  To simulate
- * the loading of a normal system, constant signature generations are performed
- * in parallel with the signature verifications.
+ * This function measures signature verification on each curve supported
+ * by the ecdsa library.  Curves only supported with V2X HW are skipped
+ * on other systems.  For each curve, the latency is measured with one
+ * verification in flight, and the rate with SIG_VERIF_CURVE_DEPTH in
+ * flight.  Hashes are verified, so the cost of hashing (which differs
+ * between curves) is not included.  Results are reported in one table:
+ * requirements are only defined for NIST P256, so no comparison is made.
  *
  */
-void test_sigVerifLatencyLoaded(void)
+void test_sigVerifCurves(void)
 {
-	test_sigVerifLatency(LOADED_TEST);
+	long rate[PERF_NUM_CURVES];
+	long p50Ns[PERF_NUM_CURVES];
+	long p99Ns[PERF_NUM_CURVES];
+	int measured[PERF_NUM_CURVES];
+	int hasV2xHw;
+	int curve;
+
+#if LEGACY_SECO_LIBS
+	hasV2xHw = seco_os_abs_has_v2x_hw();
+#else
+	hasV2xHw = plat_os_abs_has_v2x_hw();
+#endif
+
+	verifOfHash = 1;
+	for (curve = 0; curve < PERF_NUM_CURVES; curve++) {
+		measured[curve] = 0;
+		if (perfCurves[curve].needsV2xHw && !hasV2xHw)
+			continue;
+
+		/* Populate data for test on this curve */
+		perfCurve = &perfCurves[curve];
+		if (populateTestData(TEST_TYPE_SIG_VERIF_CURVE))
+			break;
+
+		VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+		/* Latency, one verification in flight */
+		if (measureSigVerifRate(1, SIG_CURVE_VERIF_NUM)) {
+			p50Ns[curve] = vtestHistPercentile(&latencyHist, 50.0f);
+			p99Ns[curve] = vtestHistPercentile(&latencyHist, 99.0f);
+			/* Rate, several verifications in flight */
+			rate[curve] = measureSigVerifRate(SIG_VERIF_CURVE_DEPTH,
+							SIG_CURVE_VERIF_NUM);
+			measured[curve] = (rate[curve] != 0);
+		}
+		VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+
+		/* Free allocated data */
+		freeTestData(TEST_TYPE_SIG_VERIF_CURVE);
+	}
+	verifOfHash = 0;
+	perfCurve = &perfCurves[0];
+
+	/* Report comparison table */
+	VTEST_LOG("Curve      verifs/sec   p50 ms   p99 ms\n");
+	for (curve = 0; curve < PERF_NUM_CURVES; curve++) {
+		if (!measured[curve]) {
+			VTEST_LOG("%-10s not measured\n", perfCurves[curve].name);
+			continue;
+		}
+		VTEST_LOG("%-10s %-12ld %-8.2f %-8.2f\n", perfCurves[curve].name,
+				rate[curve], p50Ns[curve] / (float)1000000,
+				p99Ns[curve] / (float)1000000);
+	}
 }
 
 /**
- *
- * @brief Test latency of signature verification in unloaded system
- *
- * This function tests the latency of signature verification in an unloaded
- * system.  Only the signature verification is running when measuring the
- * latency.
+ * @brief   Free data of the message size sweep
  *
  */
-void test_sigVerifLatencyUnloaded(void)
+static void freeSweepData(void)
 {
-	test_sigVerifLatency(UNLOADED_TEST);
+	free(sigArray);
+	sigArray = NULL;
+	free(hashArray);
+	hashArray = NULL;
+	free(sweepMsgData);
+	sweepMsgData = NULL;
 }
 
 /**
+ * @brief   Create data of the message size sweep
  *
- * @brief Test latency of signature generation.
+ * Creates SIG_MSG_SWEEP_NUM random messages of msgSize bytes, and their
+ * hashes and signatures.  The time to hash the messages with ecdsa_sha256
+ * is measured.  Keys must be created in pubKeyArray and ecdsa opened.
  *
- * This function tests the latency of signature generation.  If requested,
- * simulation of a loaded system is done using constant signature verifications
- * in parallel with the signature generations.
+ * @param msgSize size of messages, in bytes
+ * @param nsHash time to hash one message, in ns
  *
- * @param testType indicates whether test should run on loaded system or not
+ * @return VTEST_PASS or VTEST_FAIL
  *
  */
-void test_sigGenLatency(uint32_t testType)
+static int createSweepData(size_t msgSize, long *nsHash)
 {
-	TypeSW_t statusCode;
-	TypeSignature_t signature;
-	int32_t i;
-	float sigGenMinLatencyMs;
-	float sigGenMaxLatencyMs;
-	long nsLatency;
-
-	/* Populate data for test */
-	if (populateTestData(TEST_TYPE_SIG_GEN_LATENCY))
-		return;
-
-	/* Move to ACTIVATED state, normal operating mode */
-	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
-
-	if (testType == LOADED_TEST) {
-		/* Set up for parallel signature verification */
-		VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
-		/*
-		 * Assume sig verif is not 10 times faster than sig gen,
-		 * so loop count below will keep the verifs running during
-		 * the whole test.
-		 * The count will be forced to 0 at the end to stop the test.
-		 */
-		loopCount = SIG_LATENCY_GEN_NUM * 10;
-		/*
-		 * Use canned hash, key & sig for parallel sig verif.
-		 * Performance of sig verif operations not measured so don't
-		 * care about possible cache effects of always using same data.
-		 */
-		verif_hash = (ecdsa_hash_t)cannedHash.data;
-		verif_pubkey.x = cannedPubkeyNIST256_X;
-		verif_pubkey.y = cannedPubkeyNIST256_Y;
-		verif_sig.r = cannedSigNIST256_R;
-		verif_sig.s = cannedSigNIST256_S;
-
-		/* Start parallel signature verification */
-		VTEST_CHECK_RESULT_ASYNC_INC(
-			ecdsa_verify_signature(ECDSA_CURVE_NISTP256, verif_pubkey,
-				verif_hash, verif_sig, 0,
-				signatureVerificationCallback_background, (void *)0),
-			ECDSA_NO_ERROR, count_async);
-	}
+	long nsTimeDiff;
+	int i;
 
-	/* Init max & min before first measurement */
-	nsMinLatency = SIG_LATENCY_MIN_INIT;
-	nsMaxLatency = SIG_LATENCY_MAX_INIT;
+	sigArray = NULL;
+	sweepMsgSize = msgSize;
+	sweepMsgData = malloc(SIG_MSG_SWEEP_NUM * msgSize);
+	hashArray = calloc(SIG_MSG_SWEEP_NUM, sizeof(TypeHash_t));
+	VTEST_CHECK_RESULT((!sweepMsgData || !hashArray), 0);
+	if (!sweepMsgData || !hashArray)
+		goto fail;
 
-	/* Loop to generate the signatures */
-	for (i = 0; i < SIG_LATENCY_GEN_NUM; i++) {
-		/* Get start time */
-		if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
-			VTEST_FLAG_CONF();
-			goto stopGenLatencyTest;
-		}
-		/* Generate the signature */
-		VTEST_CHECK_RESULT(v2xSe_createRtSign(i % NUM_KEYS_PERF_TESTS,
-				&hashArray[i],	&statusCode, &signature),
-				V2XSE_SUCCESS);
-		/* Get end time */
-		if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
+	for (i = 0; i < SIG_MSG_SWEEP_NUM; i++) {
+		if (fillRandomData(sweepMsgData + i * msgSize, msgSize)) {
 			VTEST_FLAG_CONF();
-			goto stopGenLatencyTest;
+			goto fail;
 		}
-
-		/* Calculate latency */
-		CALCULATE_TIME_DIFF_NS(startTime, endTime, nsLatency);
-
-		/* Update max/min if required */
-		if (nsLatency > nsMaxLatency)
-			nsMaxLatency = nsLatency;
-		if (nsLatency < nsMinLatency)
-			nsMinLatency = nsLatency;
 	}
 
-	/* Calculate max/min latency */
-	sigGenMinLatencyMs = nsMinLatency / (float)1000000;
-	sigGenMaxLatencyMs = nsMaxLatency / (float)1000000;
-	VTEST_LOG("Sig gen latency: %.2f ms min, %.2f ms max (allow %.2f)\n",
-			sigGenMinLatencyMs, sigGenMaxLatencyMs,
-			SIG_VERIF_LATENCY_THRESHOLD);
-
-	/* Compare to requirement */
-	VTEST_CHECK_RESULT(sigGenMaxLatencyMs > SIG_GEN_LATENCY_THRESHOLD, 0);
-
-stopGenLatencyTest:
-	if (testType == LOADED_TEST) {
-		/* Stop parallel signature verification */
-		loopCount = 0;
-		/* Clean up - loops should be finished soon */
-		VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
-		VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+	/* Time hashing of messages alone */
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		goto fail;
+	}
+	for (i = 0; i < SIG_MSG_SWEEP_NUM; i++)
+		VTEST_CHECK_RESULT(ecdsa_sha256(sweepMsgData + i * msgSize,
+				msgSize, hashArray[i].data), ECDSA_NO_ERROR);
+	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
+		VTEST_FLAG_CONF();
+		goto fail;
 	}
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	*nsHash = nsTimeDiff / SIG_MSG_SWEEP_NUM;
 
-	/* Free allocated data */
-	freeTestData(TEST_TYPE_SIG_GEN_LATENCY);
+	sigArray = createSigArray(SIG_MSG_SWEEP_NUM, hashArray,
+							NUM_KEYS_PERF_TESTS);
+	VTEST_CHECK_RESULT((!sigArray), 0);
+	if (!sigArray)
+		goto fail;
+	return VTEST_PASS;
 
-/* Go back to init to leave system in known state after test */
-	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+fail:
+	freeSweepData();
+	return VTEST_FAIL;
 }
 
 /**
+ * @brief   Measure signature verification for one message size
  *
- * @brief Test latency of signature generation in a loaded system
+ * Measures the time to hash SIG_MSG_SWEEP_NUM random messages of msgSize
+ * bytes with ecdsa_sha256, and the rate of verification of the messages
+ * and of their hashes.  Keys must be created in pubKeyArray and ecdsa
+ * opened.
  *
- * This function tests the latency of signature generation in a loaded
- * system. Simulation of a loaded system is done using constant signature
- * verifications in parallel with the signature generations.
+ * @param msgSize size of messages, in bytes
+ * @param nsHash time to hash one message, in ns
+ * @param msgRate rate of message verification, in verifs/sec
+ * @param hashRate rate of hash verification, in verifs/sec
+ *
+ * @return VTEST_PASS or VTEST_FAIL
  *
  */
-void test_sigGenLatencyLoaded(void)
+static int measureSigVerifMsgSize(size_t msgSize, long *nsHash,
+					long *msgRate, long *hashRate)
 {
-	test_sigGenLatency(LOADED_TEST);
+	if (createSweepData(msgSize, nsHash))
+		return VTEST_FAIL;
+
+	/* Verify messages, then hashes alone */
+	*msgRate = measureSigVerifRate(SIG_MSG_SWEEP_DEPTH, SIG_MSG_SWEEP_NUM);
+	verifOfHash = 1;
+	*hashRate = measureSigVerifRate(SIG_MSG_SWEEP_DEPTH,
+							SIG_MSG_SWEEP_NUM);
+	verifOfHash = 0;
+
+	freeSweepData();
+	return (*msgRate && *hashRate) ? VTEST_PASS : VTEST_FAIL;
 }
 
 /**
  *
- * @brief Test latency of signature generation in an unloaded system
+ * @brief Test rate of signature verification versus message size
  *
- * This function tests the latency of signature generation in an unloaded
- * system. Only the signature generation is performed when the latency is
- * measured.
+ * This function measures the rate of verification of messages from
+ * SIG_MSG_SWEEP_MIN_SIZE to SIG_MSG_SWEEP_MAX_SIZE bytes, doubling the size
+ * at each step.  For each size, the SHA-256 throughput and the share of
+ * verification time spent hashing, compared to the ECC verification of
+ * the hash, are reported.  This shows the size where hashing starts to
+ * dominate verification cost.
  *
  */
-void test_sigGenLatencyUnloaded(void)
+void test_sigVerifMsgSize(void)
 {
-	test_sigGenLatency(UNLOADED_TEST);
-}
+	size_t msgSize;
+	long nsHash;
+	long msgRate;
+	long hashRate;
+	long nsEcc;
 
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
 
-static uint8_t *message = (uint8_t *)
-"To be, or not to be, that is the question,\n"
-"Whether 'tis nobler in the mind to suffer\n"
-"The slings and arrows of outrageous fortune,\n"
-"Or to take arms against a sea of troubles,\n"
-"And by opposing end them? To die: to sleep;\n"
-"No more; and by a sleep to say we end\n"
-"The heart-ache and the thousand natural shoc\n";
-/** Length of message used for performance tests */
-#define MESSAGE_LEN strlen((char *)message)
+	/* Generate keys to sign with */
+	pubKeyArray = createPubKeyArray(NUM_KEYS_PERF_TESTS,
+							V2XSE_CURVE_NISTP256);
+	VTEST_CHECK_RESULT((!pubKeyArray), 0);
+	if (!pubKeyArray) {
+		VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+		return;
+	}
 
-static TypeHash_t testHash;
-static uint8_t ecdsa_x[V2XSE_384_EC_PUB_KEY_XY_SIZE];
-static uint8_t ecdsa_y[V2XSE_384_EC_PUB_KEY_XY_SIZE];
-static uint8_t ecdsa_r[V2XSE_384_EC_R_SIGN];
-static uint8_t ecdsa_s[V2XSE_384_EC_S_SIGN];
-static long nVerifs;	/* number of sig verifs performed */
-static long nsSpentVerifs; /* elapsed time since begining of verif test */
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+	VTEST_LOG("Size (B)   msg verifs/sec  hash verifs/sec  SHA-256 MB/s"
+							"  hashing %%\n");
+	for (msgSize = SIG_MSG_SWEEP_MIN_SIZE;
+			msgSize <= SIG_MSG_SWEEP_MAX_SIZE; msgSize *= 2) {
+		if (measureSigVerifMsgSize(msgSize, &nsHash, &msgRate,
+							&hashRate))
+			break;
+		nsEcc = 1000000000 / hashRate;
+		VTEST_LOG("%-10zu %-15ld %-16ld %-13.1f %.1f\n", msgSize,
+			msgRate, hashRate, nsHash ?
+			msgSize * 1000 / (float)nsHash : 0,
+			nsHash * 100 / (float)(nsHash + nsEcc));
+	}
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+
+	/* Delete keys after use */
+	deletePubKeyArray(pubKeyArray, NUM_KEYS_PERF_TESTS);
+	pubKeyArray = NULL;
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/** Digests computed by the host pre-hashing threads */
+static TypeHash_t *preHashDigests;
+/** Index of next message to pre-hash */
+static long preHashNext;
+/** Counts verifications that may still be put in flight by pre-hashing */
+static sem_t preHashDepth;
 
 /**
- * @brief Test rate of signature verification
+ * @brief   Signature verification callback: host pre-hashing test
  *
- * @param[in]  sequence_number       sequence operation id (not used)
- * @param[out] ret                   returned value by the ECDSA dispatcher
+ * @param[in]  sequence_number       request slot of the operation
+ * @param[out] ret                   returned value by the dispatcher
  * @param[out] verification_result   verification result
  *
  */
-static void signatureVerificationCallback(void *sequence_number,
+static void signatureVerificationCallback_preHash(void *sequence_number,
 	int ret,
 	ecdsa_verification_result_t verification_result)
 {
-	struct timespec currTime;
+	vtestAsyncReq_t req;
 
-	/* One more signature verification performed */
-	nVerifs++;
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
 
-	/* Check correctness of the verification operation */
-	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
+	/* Log end time on last verification, before releasing the test */
+	pthread_mutex_lock(&loopLock);
+	if ((--loopsPending == 0) &&
+			(clock_gettime(CLOCK_BOOTTIME, &endTime) == -1))
+		VTEST_FLAG_CONF();
+	pthread_mutex_unlock(&loopLock);
+	sem_post(&preHashDepth);
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
+}
 
-	/* Check if test duration has been reached */
-	if (clock_gettime(CLOCK_BOOTTIME, &currTime) == -1)
-		return;
-	CALCULATE_TIME_DIFF_NS(startTime, currTime, nsSpentVerifs);
-	if (nsSpentVerifs >= SIG_GEN_VERIF_TIME_SECONDS * 1e9) {
-		/* Test is over: set loopCount to 0 to terminate the loop */
-		loopCount = 0;
-		return;
+/**
+ * @brief   Host pre-hashing thread
+ *
+ * Takes the next message of the message size sweep data, hashes it with
+ * ecdsa_sha256 and sends verification of the digest, until all messages
+ * have been taken.  Several threads share the messages, so hashing runs
+ * in parallel on the application cores while the verifications run.
+ *
+ * @param arg unused
+ *
+ * @return NULL
+ *
+ */
+static void *preHashWorker(void *arg)
+{
+	ecdsa_pubkey_t pubkey;
+	ecdsa_sig_t sig;
+	long idx;
+
+	while ((idx = __atomic_fetch_add(&preHashNext, 1, __ATOMIC_RELAXED))
+						< SIG_MSG_SWEEP_NUM) {
+		VTEST_CHECK_RESULT(ecdsa_sha256(sweepMsgData +
+				idx * sweepMsgSize, sweepMsgSize,
+				preHashDigests[idx].data), ECDSA_NO_ERROR);
+
+		/* Wait for room in flight, then send the verification */
+		sem_wait(&preHashDepth);
+		pubkey.x = pubKeyArray[idx % NUM_KEYS_PERF_TESTS].x;
+		pubkey.y = pubKeyArray[idx % NUM_KEYS_PERF_TESTS].y;
+		sig.r = sigArray[idx].r;
+		sig.s = sigArray[idx].s;
+		VTEST_CHECK_RESULT_ASYNC_INC(
+			ecdsa_verify_signature(ECDSA_CURVE_NISTP256, pubkey,
+				(ecdsa_hash_t)preHashDigests[idx].data, sig, 0,
+				signatureVerificationCallback_preHash,
+				REQ_VERIF_PASS(&count_async,
+					ASYNC_OP_VERIF_HASH)),
+			ECDSA_NO_ERROR, count_async);
 	}
-
-	/* Perform another signature verification */
-	VTEST_CHECK_RESULT_ASYNC_INC(
-		ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
-			verif_pubkey, message, MESSAGE_LEN, verif_sig, 0,
-			signatureVerificationCallback, (void *)0),
-		ECDSA_NO_ERROR, count_async);
+	return NULL;
 }
 
 /**
- * @brief Test rate of signature verification
+ * @brief   Measure verification rate of messages hashed on the host
  *
- * @param ptr not used
+ * Verifies the messages of the message size sweep data end to end:
+ * numThreads host threads hash the messages and send verification of
+ * the digests, keeping up to SIG_MSG_SWEEP_DEPTH verifications in flight.
+ * Sweep data must be created and ecdsa opened.
+ *
+ * @param numThreads number of host hashing threads
+ *
+ * @return verification rate in verifs/sec, or 0 on failure
  *
  */
-static void *verif_thread(void *ptr)
+static long measureSigVerifPreHash(int numThreads)
 {
-	long sigVerifRate;
-	long threshold;
-
-#if LEGACY_SECO_LIBS
-	if (seco_os_abs_has_v2x_hw())
-#else
-	if (plat_os_abs_has_v2x_hw())
-#endif
-		threshold = SIG_VERIF_RATE_THRESHOLD_V2XFW;
-	else
-		threshold = SIG_VERIF_RATE_THRESHOLD_SECOFW;
-
-	/*
-	 * Count the number of signature verifications that can be perfomed
-	 * during the test duration.
-	 * Counter variable is incremented in the callback function.
-	 */
-	nVerifs = 0;
-	loopCount = 100000000;
-	/*
-	 * loopCount: number of signatures high enough not to be reached.
-	 *            Time elapsed will be used to stop the verification loop.
-	 */
-	/* Perform signature verification */
-	VTEST_CHECK_RESULT_ASYNC_INC(
-		ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
-			verif_pubkey, message, MESSAGE_LEN, verif_sig, 0,
-			signatureVerificationCallback, (void *)0),
-		ECDSA_NO_ERROR, count_async);
+	pthread_t threads[SIG_PREHASH_MAX_THREADS];
+	long nsTimeDiff;
+	int numStarted;
+	int i;
 
-	/* Wait for signature verification loop completion */
-	VTEST_CHECK_RESULT_ASYNC_LOOP(count_async, loopCount);
+	preHashDigests = calloc(SIG_MSG_SWEEP_NUM, sizeof(TypeHash_t));
+	VTEST_CHECK_RESULT((!preHashDigests), 0);
+	if (!preHashDigests)
+		return 0;
+	sem_init(&preHashDepth, 0, SIG_MSG_SWEEP_DEPTH);
+	preHashNext = 0;
+	loopsPending = SIG_MSG_SWEEP_NUM;
 
-	VTEST_LOG("Elapsed time for %ld signature verifications: %ld ms\n",
-			nVerifs, nsSpentVerifs / 1000000);
-	sigVerifRate = nVerifs * 1000000000 / nsSpentVerifs;
-	VTEST_LOG("Signature verification rate: %ld verifs/sec (expect %d)\n",
-			sigVerifRate, threshold);
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		numThreads = 0;
+	}
+	for (numStarted = 0; numStarted < numThreads; numStarted++) {
+		if (pthread_create(&threads[numStarted], NULL, preHashWorker,
+								NULL)) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+	}
+	for (i = 0; i < numStarted; i++)
+		pthread_join(threads[i], NULL);
+	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, ASYNC_LOOP_TIMEOUT);
 
-	/* Compare to signature verification requirement */
-	VTEST_CHECK_RESULT(sigVerifRate < threshold, 0);
+	sem_destroy(&preHashDepth);
+	free(preHashDigests);
+	preHashDigests = NULL;
 
-	return NULL;
+	/* Check test finished as expected */
+	if ((numStarted < numThreads) || !numStarted || loopsPending)
+		return 0;
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	return SIG_MSG_SWEEP_NUM * 1000000000 / nsTimeDiff;
 }
 
 /**
  *
- * @brief Test rate of signature generation / verification
+ * @brief Compare host pre-hashing with verification of messages
  *
- * This function starts a thread to test the following in parallel:
- * o signature generation rate
- * o signature verification rate
+ * This function compares two ways of verifying messages end to end, for
+ * sizes from SIG_MSG_SWEEP_MIN_SIZE to SIG_MSG_SWEEP_MAX_SIZE: sending
+ * the messages to ecdsa_verify_signature_of_message, which hashes them
+ * inside the library, and hashing them on the host with 1, 2...
+ * SIG_PREHASH_MAX_THREADS threads in parallel, sending the digests to
+ * ecdsa_verify_signature.  This shows whether hashing on the application
+ * cores increases verification throughput.
  *
  */
-void test_sigGenVerifRate(void)
+void test_sigVerifPreHash(void)
 {
-	int ret;
-	long n, nsSpent, sigGenRate;
-	pthread_t thread_verif;
-	TypeSW_t hsmStatusCode;
-	TypePublicKey_t pubKey;
-	TypeSignature_t signature;
-	struct timespec currTime;
+	size_t msgSize;
+	long nsHash;
+	long msgRate;
+	long preHashRate;
+	int numThreads;
 
-	VTEST_RETURN_CONF_IF_NO_V2X_HW();
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
 
-	/* Set up pub key and signature structures for ECDSA verifications */
-	verif_pubkey.x = ecdsa_x;
-	verif_pubkey.y = ecdsa_y;
-	verif_sig.r    = ecdsa_r;
-	verif_sig.s    = ecdsa_s;
+	/* Generate keys to sign with */
+	pubKeyArray = createPubKeyArray(NUM_KEYS_PERF_TESTS,
+							V2XSE_CURVE_NISTP256);
+	VTEST_CHECK_RESULT((!pubKeyArray), 0);
+	if (!pubKeyArray) {
+		VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+		return;
+	}
 
-	/* Use ECDSA to verify signature */
 	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+	for (msgSize = SIG_MSG_SWEEP_MIN_SIZE;
+			msgSize <= SIG_MSG_SWEEP_MAX_SIZE; msgSize *= 4) {
+		if (createSweepData(msgSize, &nsHash))
+			break;
+		msgRate = measureSigVerifRate(SIG_MSG_SWEEP_DEPTH,
+							SIG_MSG_SWEEP_NUM);
+		VTEST_LOG("%zu B messages, of_message: %ld verifs/sec\n",
+							msgSize, msgRate);
+		for (numThreads = 1; numThreads <= SIG_PREHASH_MAX_THREADS;
+							numThreads *= 2) {
+			preHashRate = measureSigVerifPreHash(numThreads);
+			VTEST_LOG("%zu B messages, pre-hashed by %d threads:"
+				" %ld verifs/sec (x%.2f)\n", msgSize,
+				numThreads, preHashRate, msgRate ?
+				preHashRate / (float)msgRate : 0);
+		}
+		freeSweepData();
+	}
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
 
-	/* Move to ACTIVATED state, normal operating mode */
-	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+	/* Delete keys after use */
+	deletePubKeyArray(pubKeyArray, NUM_KEYS_PERF_TESTS);
+	pubKeyArray = NULL;
 
-	/* Generate ECC key pair */
-	VTEST_CHECK_RESULT(v2xSe_generateRtEccKeyPair(SLOT_ZERO,
-			V2XSE_CURVE_NISTP256, &hsmStatusCode, &pubKey),
-		V2XSE_SUCCESS);
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
 
-#ifndef ECC_PATTERNS_BIG_ENDIAN
-	/* Convert public key for ECSDA verification */
-	convertEndianness(pubKey.x, ecdsa_x, V2XSE_256_EC_PUB_KEY_XY_SIZE);
-	convertEndianness(pubKey.y, ecdsa_y, V2XSE_256_EC_PUB_KEY_XY_SIZE);
-#else
-	memcpy(ecdsa_x, pubKey.x, V2XSE_256_EC_PUB_KEY_XY_SIZE);
-	memcpy(ecdsa_y, pubKey.y, V2XSE_256_EC_PUB_KEY_XY_SIZE);
-#endif
+/**
+ * @brief   Set compressed form of the test keys for decompression tests
+ *
+ * The compressed y of each key is the LSB of its y coordinate, in the
+ * first byte, as expected by the ecdsa library.
+ *
+ */
+static void setupDecompPubKeys(void)
+{
+	int i;
 
-	/* Calculate digest value of test message */
-	VTEST_CHECK_RESULT(ecdsa_sha256(message, MESSAGE_LEN, testHash.data),
-			ECDSA_NO_ERROR);
+	memset(decompPubKeyY, 0, sizeof(decompPubKeyY));
+	for (i = 0; i < NUM_KEYS_PERF_TESTS; i++)
+		decompPubKeyY[i][0] =
+			pubKeyArray[i].y[perfCurve->keySize - 1] & 1;
+}
 
-	/* Calculate a signature to feed the verification thread */
-	VTEST_CHECK_RESULT(v2xSe_createRtSign(SLOT_ZERO,
-			&testHash, &hsmStatusCode, &signature),
-			V2XSE_SUCCESS);
+/**
+ *
+ * @brief Test rate and latency of public key decompression
+ *
+ * This function measures, on each curve supported by the ecdsa library,
+ * decompression of public keys alone, decompression followed by
+ * verification of a hash with the decompressed key, and the fused
+ * ecdsa_decompress_and_verify_signature call.  Curves only supported
+ * with V2X HW are skipped on other systems.  For each case, the latency
+ * is measured with one operation in flight, and the rate with
+ * SIG_VERIF_CURVE_DEPTH in flight.  Results are reported in one table,
+ * with no requirement to compare to.
+ *
+ */
+void test_sigVerifDecomp(void)
+{
+	static char *modeName[DECOMP_NUM_MODES] = {
+		"decompress",
+		"decomp+verif",
+		"fused"
+	};
+	long rate[PERF_NUM_CURVES][DECOMP_NUM_MODES];
+	long p50Ns[PERF_NUM_CURVES][DECOMP_NUM_MODES];
+	long p99Ns[PERF_NUM_CURVES][DECOMP_NUM_MODES];
+	int measured[PERF_NUM_CURVES][DECOMP_NUM_MODES];
+	int hasV2xHw;
+	int curve;
+	int mode;
 
-#ifndef ECC_PATTERNS_BIG_ENDIAN
-	/* Convert signature for ECDSA verification */
-	convertEndianness(signature.r, ecdsa_r, V2XSE_256_EC_R_SIGN);
-	convertEndianness(signature.s, ecdsa_s, V2XSE_256_EC_S_SIGN);
+#if LEGACY_SECO_LIBS
+	hasV2xHw = seco_os_abs_has_v2x_hw();
 #else
-	memcpy(ecdsa_r, signature.r, V2XSE_256_EC_R_SIGN);
-	memcpy(ecdsa_s, signature.s, V2XSE_256_EC_S_SIGN);
+	hasV2xHw = plat_os_abs_has_v2x_hw();
 #endif
 
-	/* Get test starting time */
-	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
-		VTEST_FLAG_CONF();
-		goto end;
-	}
-
-	/* Create signature verification thread */
-	ret = pthread_create(&thread_verif, NULL, verif_thread, NULL);
-	if (ret) {
-		VTEST_LOG("Could not create thread for signature verification\n");
-		VTEST_FLAG_CONF();
-		goto end;
-	}
+	memset(measured, 0, sizeof(measured));
+	for (curve = 0; curve < PERF_NUM_CURVES; curve++) {
+		if (perfCurves[curve].needsV2xHw && !hasV2xHw)
+			continue;
 
-	/*
-	 * Count the number of signature generations that can be perfomed during
-	 * the test duration.
-	 */
-	n = 0;
-	do {
-		/* Perform a signature generation */
-		VTEST_CHECK_RESULT(v2xSe_createRtSign(SLOT_ZERO,
-				&testHash, &hsmStatusCode, &signature),
-				V2XSE_SUCCESS);
-		n++;
+		/* Populate data for test on this curve */
+		perfCurve = &perfCurves[curve];
+		if (populateTestData(TEST_TYPE_SIG_VERIF_CURVE))
+			break;
+		setupDecompPubKeys();
 
-		if (clock_gettime(CLOCK_BOOTTIME, &currTime) == -1) {
-			VTEST_FLAG_CONF();
-			goto end;
+		VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+		for (mode = 0; mode < DECOMP_NUM_MODES; mode++) {
+			decompMode = DECOMP_MODE_DECOMP + mode;
+			/* Latency, one operation in flight */
+			if (!measureSigVerifRate(1, SIG_CURVE_VERIF_NUM))
+				continue;
+			p50Ns[curve][mode] = vtestHistPercentile(&latencyHist,
+									50.0f);
+			p99Ns[curve][mode] = vtestHistPercentile(&latencyHist,
+									99.0f);
+			/* Rate, several operations in flight */
+			rate[curve][mode] = measureSigVerifRate(
+				SIG_VERIF_CURVE_DEPTH, SIG_CURVE_VERIF_NUM);
+			measured[curve][mode] = (rate[curve][mode] != 0);
 		}
-		CALCULATE_TIME_DIFF_NS(startTime, currTime, nsSpent);
-	} while (nsSpent < SIG_GEN_VERIF_TIME_SECONDS * 1e9);
+		decompMode = 0;
+		VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
 
-	VTEST_LOG("Elapsed time for %ld signature generations: %ld ms\n",
-			n, nsSpent / 1000000);
-	sigGenRate = n * 1000000000 / nsSpent;
-	VTEST_LOG("Signature generation rate: %ld gens/sec (expect %d)\n",
-			sigGenRate, SIG_GEN_RATE_THRESHOLD);
+		/* Free allocated data */
+		freeTestData(TEST_TYPE_SIG_VERIF_CURVE);
+	}
+	perfCurve = &perfCurves[0];
+
+	/* Report comparison table */
+	VTEST_LOG("Curve      Operation      ops/sec      p50 ms   p99 ms\n");
+	for (curve = 0; curve < PERF_NUM_CURVES; curve++) {
+		for (mode = 0; mode < DECOMP_NUM_MODES; mode++) {
+			if (!measured[curve][mode]) {
+				VTEST_LOG("%-10s %-14s not measured\n",
+						perfCurves[curve].name,
+						modeName[mode]);
+				continue;
+			}
+			VTEST_LOG("%-10s %-14s %-12ld %-8.2f %-8.2f\n",
+				perfCurves[curve].name, modeName[mode],
+				rate[curve][mode],
+				p50Ns[curve][mode] / (float)1000000,
+				p99Ns[curve][mode] / (float)1000000);
+		}
+	}
+}
 
-	/* Compare to signature generation requirement */
-	VTEST_CHECK_RESULT(sigGenRate < SIG_GEN_RATE_THRESHOLD, 0);
+/**
+ *
+ * @brief Test rate and latency of public key reconstruction
+ *
+ * This function measures reconstruction of implicit certificate public
+ * keys on each curve supporting it, using a distinct input for each
+ * reconstruction.  The rate and its p99 latency are measured with
+ * PUBKEY_RECON_DEPTH reconstructions in flight, and the latency alone
+ * with one in flight.  Results are reported in one table, with no
+ * requirement to compare to.
+ *
+ */
+void test_pubKeyReconRate(void)
+{
+	long rate[PERF_NUM_CURVES];
+	long p99Ns[PERF_NUM_CURVES];
+	long p50NsUnloaded[PERF_NUM_CURVES];
+	long p99NsUnloaded[PERF_NUM_CURVES];
+	int measured[PERF_NUM_CURVES];
+	int hasV2xHw;
+	int curve;
 
-	/* Wait for verification thread's completion */
-	pthread_join(thread_verif, NULL);
+#if LEGACY_SECO_LIBS
+	hasV2xHw = seco_os_abs_has_v2x_hw();
+#else
+	hasV2xHw = plat_os_abs_has_v2x_hw();
+#endif
 
-end:
-	/* Delete key after use */
-	VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(SLOT_ZERO,
-				&hsmStatusCode), V2XSE_SUCCESS);
+	reconMode = 1;
+	for (curve = 0; curve < PERF_NUM_CURVES; curve++) {
+		measured[curve] = 0;
+		if (!perfCurves[curve].hasReconstruction ||
+				(perfCurves[curve].needsV2xHw && !hasV2xHw))
+			continue;
 
-/* Go back to init to leave system in known state after test */
-	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+		/* Populate data for test on this curve */
+		perfCurve = &perfCurves[curve];
+		if (populateTestData(TEST_TYPE_SIG_VERIF_CURVE))
+			break;
 
-	/* Close ecdsa session */
+		VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+		/* Latency, one reconstruction in flight */
+		if (measureSigVerifRate(1, SIG_CURVE_VERIF_NUM)) {
+			p50NsUnloaded[curve] = vtestHistPercentile(&latencyHist,
+									50.0f);
+			p99NsUnloaded[curve] = vtestHistPercentile(&latencyHist,
+									99.0f);
+			/* Rate, several reconstructions in flight */
+			rate[curve] = measureSigVerifRate(PUBKEY_RECON_DEPTH,
+							SIG_CURVE_VERIF_NUM);
+			p99Ns[curve] = vtestHistPercentile(&latencyHist, 99.0f);
+			measured[curve] = (rate[curve] != 0);
+		}
+		VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+
+		/* Free allocated data */
+		freeTestData(TEST_TYPE_SIG_VERIF_CURVE);
+	}
+	reconMode = 0;
+	perfCurve = &perfCurves[0];
+
+	/* Report comparison table */
+	VTEST_LOG("Curve      recons/sec   p99 ms   p50 ms (1 in flight)"
+						"   p99 ms (1 in flight)\n");
+	for (curve = 0; curve < PERF_NUM_CURVES; curve++) {
+		if (!perfCurves[curve].hasReconstruction)
+			continue;
+		if (!measured[curve]) {
+			VTEST_LOG("%-10s not measured\n", perfCurves[curve].name);
+			continue;
+		}
+		VTEST_LOG("%-10s %-12ld %-8.2f %-22.2f %-8.2f\n",
+				perfCurves[curve].name, rate[curve],
+				p99Ns[curve] / (float)1000000,
+				p50NsUnloaded[curve] / (float)1000000,
+				p99NsUnloaded[curve] / (float)1000000);
+	}
+}
+
+/** State of one certificate chain of the chain validation test */
+typedef struct {
+	/** Time the validation of the chain started (CLOCK_BOOTTIME) */
+	struct timespec startTime;
+	/** Number of stages left before the end-entity verification */
+	int stagesPending;
+} TypeChain_t;
+
+/** Chains of the chain validation test, indexed by loop number - 1 */
+static TypeChain_t chains[CHAIN_NUM];
+
+/**
+ * @brief   Launch the last stage of a certificate chain
+ *
+ * Called when both the issuer key decompression and the issuer
+ * verification of the chain are done: the end-entity signature is
+ * verified with the issuer key.  Its latency is counted from the start of
+ * the chain.
+ *
+ * @param loop number of the chain
+ *
+ */
+static void chainStageDone(int loop)
+{
+	TypeChain_t *chain = &chains[loop - 1];
+	vtestAsyncReq_t *req;
+	ecdsa_pubkey_t pubkey;
+	ecdsa_sig_t sig;
+	int eeIdx = 2 * (loop - 1) + 1;
+
+	if (__atomic_sub_fetch(&chain->stagesPending, 1, __ATOMIC_ACQ_REL))
+		return;
+
+	req = vtestAsyncReqIssueAt(&count_async, ASYNC_OP_VERIF_HASH,
+				ECDSA_VERIFICATION_SUCCESS, &chain->startTime);
+	if (req)
+		req->owner = loop;
+	/* Issuer key is checked identical to the decompressed one */
+	pubkey.x = pubKeyArray[eeIdx % NUM_KEYS_PERF_TESTS].x;
+	pubkey.y = pubKeyArray[eeIdx % NUM_KEYS_PERF_TESTS].y;
+	sig.r = sigArray[eeIdx].r;
+	sig.s = sigArray[eeIdx].s;
+	VTEST_CHECK_RESULT_ASYNC_INC(
+		ecdsa_verify_signature(perfCurve->eccCurveId, pubkey,
+			(ecdsa_hash_t)hashArray[eeIdx].data, sig, 0,
+			signatureVerificationCallback_rate, req),
+		ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief   Issuer key decompression callback: chain validation test
+ *
+ * @param[in]  sequence_number       request slot of the operation
+ * @param[out] ret                   returned value by the dispatcher
+ * @param[out] pubKey_decompressed   decompressed public key
+ *
+ */
+static void chainDecompCallback(void *sequence_number,
+	int ret,
+	ecdsa_pubkey_t *pubKey_decompressed)
+{
+	vtestAsyncReq_t req;
+	int status;
+
+	status = vtestAsyncReqComplete(&count_async, sequence_number, &req);
+	VTEST_CHECK_RESULT(status, VTEST_PASS);
+	if (status == VTEST_PASS) {
+		/* Issuer key is the key of the end-entity signature */
+		checkDecompPubKey(pubKey_decompressed, 2 * req.owner);
+		chainStageDone(req.owner);
+	}
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief   Issuer verification callback: chain validation test
+ *
+ * @param[in]  sequence_number       request slot of the operation
+ * @param[out] ret                   returned value by the dispatcher
+ * @param[out] verification_result   verification result
+ *
+ */
+static void chainIssuerCallback(void *sequence_number,
+	int ret,
+	ecdsa_verification_result_t verification_result)
+{
+	vtestAsyncReq_t req;
+	int status;
+
+	status = vtestAsyncReqComplete(&count_async, sequence_number, &req);
+	VTEST_CHECK_RESULT(status, VTEST_PASS);
+	if (status == VTEST_PASS) {
+		VTEST_CHECK_RESULT(verification_result, req.expResult);
+		chainStageDone(req.owner);
+	}
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief   Launch the validation of one certificate chain
+ *
+ * Chain n uses hash 2n-2, signed by the root key, as issuer certificate
+ * and hash 2n-1, signed by the issuer key, as end-entity certificate.
+ * The issuer key, received compressed, is decompressed while the issuer
+ * certificate is verified with the root key: the end-entity signature is
+ * verified as soon as both are done.
+ *
+ * @param loop number of the chain, as from nextSigVerifRateLoop
+ *
+ */
+static void launchChain(int loop)
+{
+	TypeChain_t *chain = &chains[loop - 1];
+	ecdsa_pubkey_t issuerKey;
+	ecdsa_pubkey_t rootKey;
+	vtestAsyncReq_t *req;
+	ecdsa_sig_t sig;
+	int issuerIdx = 2 * (loop - 1);
+	int eeIdx = issuerIdx + 1;
+
+	chain->stagesPending = 2;
+	if (clock_gettime(CLOCK_BOOTTIME, &chain->startTime) == -1)
+		VTEST_FLAG_CONF();
+
+	/* Decompress issuer key */
+	issuerKey.x = pubKeyArray[eeIdx % NUM_KEYS_PERF_TESTS].x;
+	issuerKey.y = decompPubKeyY[eeIdx % NUM_KEYS_PERF_TESTS];
+	req = vtestAsyncReqIssue(&count_async, ASYNC_OP_DECOMP, ECDSA_NO_ERROR);
+	if (req)
+		req->owner = loop;
+	VTEST_CHECK_RESULT_ASYNC_INC(
+		ecdsa_decompress_public_key(perfCurve->eccCurveId, issuerKey, 0,
+			chainDecompCallback, req),
+		ECDSA_NO_ERROR, count_async);
+
+	/* Verify issuer certificate with root key */
+	rootKey.x = pubKeyArray[issuerIdx % NUM_KEYS_PERF_TESTS].x;
+	rootKey.y = pubKeyArray[issuerIdx % NUM_KEYS_PERF_TESTS].y;
+	sig.r = sigArray[issuerIdx].r;
+	sig.s = sigArray[issuerIdx].s;
+	req = REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_HASH);
+	if (req)
+		req->owner = loop;
+	VTEST_CHECK_RESULT_ASYNC_INC(
+		ecdsa_verify_signature(perfCurve->eccCurveId, rootKey,
+			(ecdsa_hash_t)hashArray[issuerIdx].data, sig, 0,
+			chainIssuerCallback, req),
+		ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ *
+ * @brief Test rate and latency of certificate chain validation
+ *
+ * This function models validation of received certificates as a
+ * pipeline of dependent async operations on NIST P256: decompression of
+ * the issuer key and verification of the issuer certificate run in
+ * parallel, then the end-entity signature is verified as soon as both
+ * are done.  The number of chains validated in parallel is doubled from
+ * 1 to CHAIN_MAX_DEPTH, and the chain rate and chain latency percentiles
+ * are reported for each.
+ *
+ */
+void test_certChainRate(void)
+{
+	long rate;
+	int depth;
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_VERIF_CURVE))
+		return;
+	setupDecompPubKeys();
+
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+	chainMode = 1;
+	VTEST_LOG("Depth   chains/sec   p50 ms   p90 ms   p99 ms   max ms\n");
+	for (depth = 1; depth <= CHAIN_MAX_DEPTH; depth *= 2) {
+		rate = measureSigVerifRate(depth, CHAIN_NUM);
+		if (!rate)
+			break;
+		VTEST_LOG("%-7d %-12ld %-8.2f %-8.2f %-8.2f %-8.2f\n", depth,
+			rate,
+			vtestHistPercentile(&latencyHist, 50.0f) /
+							(float)1000000,
+			vtestHistPercentile(&latencyHist, 90.0f) /
+							(float)1000000,
+			vtestHistPercentile(&latencyHist, 99.0f) /
+							(float)1000000,
+			latencyHist.max / (float)1000000);
+	}
+	chainMode = 0;
 	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_VERIF_CURVE);
+}
+
+/**
+ *
+ * @brief Test rate of signature generation
+ *
+ * This function tests the rate of signature generation
+ *
+ */
+void test_sigGenRate(void)
+{
+	TypeSW_t statusCode;
+	TypeSignature_t signature;
+	int i;
+	long nsTimeDiff;
+	long sigGenRate;
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_GEN_RATE))
+		return;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+
+	/* Log start time */
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		freeTestData(TEST_TYPE_SIG_GEN_RATE);
+		return;
+	}
+
+	/* Generate the signatures */
+	for (i = 0; i < SIG_RATE_GEN_NUM; i++) {
+		VTEST_CHECK_RESULT(v2xSe_createRtSign(i % NUM_KEYS_PERF_TESTS,
+				&hashArray[i],	&statusCode, &signature),
+				V2XSE_SUCCESS);
+	}
+
+	/* Log end time */
+	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
+		VTEST_FLAG_CONF();
+		freeTestData(TEST_TYPE_SIG_GEN_RATE);
+		return;
+	}
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_GEN_RATE);
+
+	/* Calculate elapsed time and sig gen rate */
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	VTEST_LOG("Elapsed time for %d signature generations: %ld ns\n",
+					SIG_RATE_GEN_NUM, nsTimeDiff);
+	sigGenRate = SIG_RATE_GEN_NUM * 1000000000 / nsTimeDiff;
+	VTEST_LOG("Signature generation rate: %ld sig/sec (expect %d)\n",
+					sigGenRate, SIG_GEN_RATE_THRESHOLD);
+
+	/* Compare to requirement */
+	VTEST_CHECK_RESULT(sigGenRate < SIG_GEN_RATE_THRESHOLD, 0);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/**
+ * @brief   Generate one signature with a signing API of the API matrix
+ *
+ * Keys must be set up for the API: RT and BA keys in slots 0 to
+ * NUM_KEYS_PERF_TESTS - 1, RT key in slot 0 activated for low latency
+ * signature, or MA key.
+ *
+ * @param api signing API, one of SIG_API_*
+ * @param i number of the signature, selects the hash and key
+ * @param fast incremented if a low latency signature was fast
+ *
+ * @return V2XSE_SUCCESS or the error returned by the API
+ *
+ */
+static int32_t callSigGenApi(int api, int i, long *fast)
+{
+	TypeSW_t statusCode;
+	TypeSignature_t signature;
+	TypeLowlatencyIndicator_t fastIndicator;
+	int32_t retVal;
+	uint8_t hashLen;
+
+	hashLen = (perfCurve->keySize == V2XSE_384_EC_PUB_KEY_XY_SIZE) ?
+			V2XSE_384_EC_HASH_SIZE : V2XSE_256_EC_HASH_SIZE;
+	switch (api) {
+	case SIG_API_RT:
+		return v2xSe_createRtSign(i % NUM_KEYS_PERF_TESTS,
+				&hashArray[i], &statusCode, &signature);
+	case SIG_API_RT_LOW_LATENCY:
+		retVal = v2xSe_createRtSignLowLatency(&hashArray[i],
+				&statusCode, &signature, &fastIndicator);
+		if ((retVal == V2XSE_SUCCESS) && fastIndicator)
+			(*fast)++;
+		return retVal;
+	case SIG_API_BA:
+		return v2xSe_createBaSign(i % NUM_KEYS_PERF_TESTS, hashLen,
+				&hashArray[i], &statusCode, &signature);
+	case SIG_API_MA:
+	default:
+		return v2xSe_createMaSign(hashLen, &hashArray[i], &statusCode,
+								&signature);
+	}
+}
+
+/**
+ * @brief   Measure rate and latency of one signing API
+ *
+ * Generates SIG_RATE_GEN_NUM signatures back to back, recording the
+ * latency of each in latencyHist.  Keys must be set up as required by
+ * callSigGenApi.
+ *
+ * @param api signing API, one of SIG_API_*
+ * @param fast number of fast low latency signatures
+ *
+ * @return signature rate in sig/sec, or 0 on failure
+ *
+ */
+static long measureSigGenApi(int api, long *fast)
+{
+	struct timespec sigStart, sigEnd;
+	long nsTimeDiff;
+	int i;
+
+	vtestHistReset(&latencyHist);
+	*fast = 0;
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	for (i = 0; i < SIG_RATE_GEN_NUM; i++) {
+		if (clock_gettime(CLOCK_BOOTTIME, &sigStart) == -1) {
+			VTEST_FLAG_CONF();
+			return 0;
+		}
+		VTEST_CHECK_RESULT(callSigGenApi(api, i, fast), V2XSE_SUCCESS);
+		if (clock_gettime(CLOCK_BOOTTIME, &sigEnd) == -1) {
+			VTEST_FLAG_CONF();
+			return 0;
+		}
+		CALCULATE_TIME_DIFF_NS(sigStart, sigEnd, nsTimeDiff);
+		vtestHistRecord(&latencyHist, nsTimeDiff);
+	}
+	endTime = sigEnd;
+
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	return SIG_RATE_GEN_NUM * 1000000000 / nsTimeDiff;
+}
+
+/**
+ *
+ * @brief Test rate and latency of each signing API on each curve
+ *
+ * This function measures v2xSe_createRtSign, v2xSe_createRtSignLowLatency
+ * (with one key activated), v2xSe_createBaSign and v2xSe_createMaSign on
+ * each curve supported by the SE.  Curves only supported with V2X HW are
+ * skipped on other systems.  The MA key can only be generated after
+ * removing the NVM phase variable, which deletes all keys, so the MA
+ * signature is measured last for each curve.  Results are reported in
+ * one table, with no requirement to compare to.
+ *
+ */
+void test_sigGenApis(void)
+{
+	static char *apiName[SIG_API_NUM] = {
+		"Rt",
+		"RtLowLatency",
+		"Ba",
+		"Ma"
+	};
+	TypeSW_t statusCode;
+	TypePublicKey_t pubKey;
+	long rate[PERF_NUM_CURVES][SIG_API_NUM];
+	long p50Ns[PERF_NUM_CURVES][SIG_API_NUM];
+	long p99Ns[PERF_NUM_CURVES][SIG_API_NUM];
+	long maxNs[PERF_NUM_CURVES][SIG_API_NUM];
+	long fast[PERF_NUM_CURVES];
+	long numFast;
+	int hasV2xHw;
+	int curve;
+	int api;
+	int i;
+
+#if LEGACY_SECO_LIBS
+	hasV2xHw = seco_os_abs_has_v2x_hw();
+#else
+	hasV2xHw = plat_os_abs_has_v2x_hw();
+#endif
+
+	memset(rate, 0, sizeof(rate));
+	for (curve = 0; curve < PERF_NUM_CURVES; curve++) {
+		if (perfCurves[curve].needsV2xHw && !hasV2xHw)
+			continue;
+
+		/* Populate data for test on this curve, with Rt keys */
+		perfCurve = &perfCurves[curve];
+		if (populateTestData(TEST_TYPE_SIG_GEN_RATE))
+			break;
+
+		/* Move to ACTIVATED state, normal operating mode */
+		VTEST_CHECK_RESULT(setupActivatedNormalState(perfCurve->applet),
+								VTEST_PASS);
+		/* Create Ba keys, activate Rt key for low latency signature */
+		for (i = 0; i < NUM_KEYS_PERF_TESTS; i++)
+			VTEST_CHECK_RESULT(v2xSe_generateBaEccKeyPair(i,
+					perfCurve->seCurveId, &statusCode,
+					&pubKey), V2XSE_SUCCESS);
+		VTEST_CHECK_RESULT(v2xSe_activateRtKeyForSigning(SLOT_ZERO,
+						&statusCode), V2XSE_SUCCESS);
+
+		for (api = 0; api < SIG_API_NUM; api++) {
+			if (api == SIG_API_MA) {
+				/* Reset phase to allow creation of MA key */
+				VTEST_CHECK_RESULT(setupInitState(),
+								VTEST_PASS);
+				VTEST_CHECK_RESULT(removeNvmVariable(
+					(perfCurve->applet == e_CN) ?
+						CN_PHASE_FILENAME :
+						EU_PHASE_FILENAME),
+					VTEST_PASS);
+				VTEST_CHECK_RESULT(setupActivatedNormalState(
+						perfCurve->applet), VTEST_PASS);
+				VTEST_CHECK_RESULT(v2xSe_generateMaEccKeyPair(
+					perfCurve->seCurveId, &statusCode,
+					&pubKey), V2XSE_SUCCESS);
+			}
+			rate[curve][api] = measureSigGenApi(api, &numFast);
+			if (api == SIG_API_RT_LOW_LATENCY)
+				fast[curve] = numFast;
+			p50Ns[curve][api] = vtestHistPercentile(&latencyHist,
+									50.0f);
+			p99Ns[curve][api] = vtestHistPercentile(&latencyHist,
+									99.0f);
+			maxNs[curve][api] = latencyHist.max;
+		}
+
+		/* Free allocated data */
+		freeTestData(TEST_TYPE_SIG_GEN_RATE);
+		VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+	}
+	perfCurve = &perfCurves[0];
+
+	/* Report comparison table */
+	VTEST_LOG("Curve      API            sig/sec  p50 ms   p99 ms   max ms\n");
+	for (curve = 0; curve < PERF_NUM_CURVES; curve++) {
+		for (api = 0; api < SIG_API_NUM; api++) {
+			if (!rate[curve][api]) {
+				VTEST_LOG("%-10s %-14s not measured\n",
+						perfCurves[curve].name,
+						apiName[api]);
+				continue;
+			}
+			VTEST_LOG("%-10s %-14s %-8ld %-8.2f %-8.2f %-8.2f\n",
+				perfCurves[curve].name, apiName[api],
+				rate[curve][api],
+				p50Ns[curve][api] / (float)1000000,
+				p99Ns[curve][api] / (float)1000000,
+				maxNs[curve][api] / (float)1000000);
+		}
+		if (rate[curve][SIG_API_RT_LOW_LATENCY])
+			VTEST_LOG("%-10s %ld of %ld low latency signatures"
+					" fast\n", perfCurves[curve].name,
+					fast[curve], SIG_RATE_GEN_NUM);
+	}
+}
+
+/** Activation latencies measured by the low latency amortization test */
+static vtestHist_t activationHist;
+
+/**
+ * @brief   Time a low latency signing case of the amortization test
+ *
+ * Runs rounds of: activate an Rt key for low latency signature, stay idle
+ * for idleMs, then generate sigsPerActivation low latency signatures,
+ * until LL_AMORT_NUM_SIGS signatures are generated.  Activation latencies
+ * are recorded in activationHist, signature latencies in latencyHist.
+ *
+ * @param sigsPerActivation number of signatures after each activation
+ * @param idleMs idle time between activation and first signature, in ms
+ * @param fast number of fast low latency signatures
+ *
+ * @return total time spent in activations and signatures in ns, or 0 on
+ *         failure
+ *
+ */
+static long measureLowLatencyAmort(int sigsPerActivation, int idleMs,
+								long *fast)
+{
+	TypeSW_t statusCode;
+	TypeSignature_t signature;
+	TypeLowlatencyIndicator_t fastIndicator;
+	struct timespec idle = {idleMs / 1000, (idleMs % 1000) * 1000000};
+	int32_t retVal;
+	struct timespec opStart, opEnd;
+	long nsTimeDiff;
+	long nsTotal = 0;
+	int round;
+	int i;
+
+	vtestHistReset(&activationHist);
+	vtestHistReset(&latencyHist);
+	*fast = 0;
+	for (round = 0; round < LL_AMORT_NUM_SIGS / sigsPerActivation;
+								round++) {
+		/* Activate a different key each round */
+		if (clock_gettime(CLOCK_BOOTTIME, &opStart) == -1)
+			goto fail;
+		VTEST_CHECK_RESULT(v2xSe_activateRtKeyForSigning(
+				round % NUM_KEYS_PERF_TESTS, &statusCode),
+				V2XSE_SUCCESS);
+		if (clock_gettime(CLOCK_BOOTTIME, &opEnd) == -1)
+			goto fail;
+		CALCULATE_TIME_DIFF_NS(opStart, opEnd, nsTimeDiff);
+		vtestHistRecord(&activationHist, nsTimeDiff);
+		nsTotal += nsTimeDiff;
+
+		if (idleMs)
+			clock_nanosleep(CLOCK_BOOTTIME, 0, &idle, NULL);
+
+		for (i = 0; i < sigsPerActivation; i++) {
+			if (clock_gettime(CLOCK_BOOTTIME, &opStart) == -1)
+				goto fail;
+			retVal = v2xSe_createRtSignLowLatency(
+				&hashArray[round * sigsPerActivation + i],
+				&statusCode, &signature, &fastIndicator);
+			if (clock_gettime(CLOCK_BOOTTIME, &opEnd) == -1)
+				goto fail;
+			VTEST_CHECK_RESULT(retVal, V2XSE_SUCCESS);
+			CALCULATE_TIME_DIFF_NS(opStart, opEnd, nsTimeDiff);
+			vtestHistRecord(&latencyHist, nsTimeDiff);
+			nsTotal += nsTimeDiff;
+			if ((retVal == V2XSE_SUCCESS) && fastIndicator)
+				(*fast)++;
+		}
+	}
+	return nsTotal;
+
+fail:
+	VTEST_FLAG_CONF();
+	return 0;
+}
+
+/**
+ *
+ * @brief Test amortization of activation for low latency signature
+ *
+ * This function measures the cost of v2xSe_activateRtKeyForSigning and
+ * how it amortizes over the v2xSe_createRtSignLowLatency calls that
+ * follow it, on NIST P256.  The number of signatures after each
+ * activation, and the idle time between the activation and the first
+ * signature (leaving time for precomputation), are varied.  For each
+ * case, the activation and signature latencies are reported, with the
+ * mean time per signature including the activation.
+ *
+ */
+void test_sigGenLowLatencyAmort(void)
+{
+	static const int idleMs[LL_AMORT_NUM_IDLE] = LL_AMORT_IDLE_MS;
+	long nsTotal;
+	long fast;
+	int sigsPerActivation;
+	int idle;
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_GEN_RATE))
+		return;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+
+	VTEST_LOG("Sigs/act  Idle ms  Act p50 ms  Act max ms  Sig p50 ms"
+			"  Sig p99 ms  Sig max ms  ms/sig  Fast\n");
+	for (sigsPerActivation = 1;
+			sigsPerActivation <= LL_AMORT_MAX_SIGS_PER_ACTIVATION;
+			sigsPerActivation *= 4) {
+		for (idle = 0; idle < LL_AMORT_NUM_IDLE; idle++) {
+			nsTotal = measureLowLatencyAmort(sigsPerActivation,
+							idleMs[idle], &fast);
+			if (!nsTotal)
+				goto exit;
+			VTEST_LOG("%-9d %-8d %-11.2f %-11.2f %-11.2f %-11.2f"
+				" %-11.2f %-7.2f %ld/%ld\n",
+				sigsPerActivation, idleMs[idle],
+				vtestHistPercentile(&activationHist, 50.0f) /
+								(float)1000000,
+				activationHist.max / (float)1000000,
+				vtestHistPercentile(&latencyHist, 50.0f) /
+								(float)1000000,
+				vtestHistPercentile(&latencyHist, 99.0f) /
+								(float)1000000,
+				latencyHist.max / (float)1000000,
+				nsTotal / (float)latencyHist.count / 1000000,
+				fast, latencyHist.count);
+		}
+	}
+
+exit:
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_GEN_RATE);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/**
+ * @brief   Log latency distribution and compare to requirement
+ *
+ * The latency at SIG_LATENCY_CHECK_PERCENTILE is compared to the threshold,
+ * and if SIG_LATENCY_CHECK_MAX is set the max latency is also compared.
+ *
+ * @param hist histogram of measured latencies
+ * @param name name of measured operation for log messages
+ * @param thresholdMs latency requirement, in ms
+ *
+ */
+static void checkLatency(vtestHist_t *hist, char *name, float thresholdMs)
+{
+	float latencyMs;
+
+	vtestHistLog(hist, name);
+	latencyMs = vtestHistPercentile(hist, SIG_LATENCY_CHECK_PERCENTILE) /
+								(float)1000000;
+	VTEST_LOG("%s latency: %.2f ms at p%.1f (allow %.2f)\n", name,
+			latencyMs, SIG_LATENCY_CHECK_PERCENTILE, thresholdMs);
+
+	/* Compare to requirement */
+	VTEST_CHECK_RESULT(latencyMs > thresholdMs, 0);
+	if (SIG_LATENCY_CHECK_MAX)
+		VTEST_CHECK_RESULT(hist->max / (float)1000000 > thresholdMs, 0);
+}
+
+/**
+ *
+ * @brief Test latency of signature verification.
+ *
+ * This function tests the latency of signature verification.  If requested,
+ * simulation of a loaded system is done using constant signature generations
+ * in parallel with the signature verifications.
+ *
+ * @param testType indicates whether test should run on loaded system or not
+ *
+ */
+void test_sigVerifLatency(uint32_t testType)
+{
+	TypeSW_t statusCode;
+	TypePublicKey_t gen_pubKey;
+	TypeSignature_t gen_signature;
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_VERIF_LATENCY))
+		return;
+
+	if (testType == LOADED_TEST) {
+		/* Move to ACTIVATED state, normal operating mode */
+		VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+		/* Create RT key for background sig gen operations */
+		VTEST_CHECK_RESULT(v2xSe_generateRtEccKeyPair(SLOT_ZERO,
+			V2XSE_CURVE_NISTP256, &statusCode, &gen_pubKey),
+								V2XSE_SUCCESS);
+	}
+
+	/* Set up system for signature verification */
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+	loopCount = SIG_LATENCY_VERIF_NUM;
+
+	/* Setup ECDSA variables to point to first data to verify */
+	SETUP_ECDSA_SIG_VERIF_PTRS(loopCount);
+
+	/* Clear latencies before first measurement */
+	vtestHistReset(&latencyHist);
+
+	/* Start verification loops */
+	VTEST_CHECK_RESULT_ASYNC_INC(
+		ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
+			verif_pubkey, verif_msg, verif_msgLen, verif_sig, 0,
+			signatureVerificationCallback_latency,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_MSG)),
+		ECDSA_NO_ERROR, count_async);
+
+	if (testType == LOADED_TEST) {
+	/*
+	 * Run parallel signature generation until verif counter goes to 0.
+	 * Use canned hash & single key for parallel sig gen.  Performance
+	 * of sig gen operations not measured so don't care about possible
+	 * cache effects of always using same data.
+	 */
+		while (loopCount > 0) {
+			VTEST_CHECK_RESULT(v2xSe_createRtSign(SLOT_ZERO,
+				&cannedHash, &statusCode, &gen_signature),
+								V2XSE_SUCCESS);
+		}
+		/* Clean up - loops should be finished */
+		VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_1_MS);
+	} else {
+	/* Unloaded test - just wait for end */
+		VTEST_CHECK_RESULT_ASYNC_LOOP(count_async, loopCount);
+	}
+
+	/* Finished verifications */
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_VERIF_LATENCY);
+
+	/* If test finished as expected */
+	if (!loopCount)
+		checkLatency(&latencyHist, "Sig verif",
+					SIG_VERIF_LATENCY_THRESHOLD);
+
+	/* Go back to init to leave system in known state after test */
+	if (testType == LOADED_TEST) {
+		/* Delete key after use */
+		VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(SLOT_ZERO,
+						&statusCode), V2XSE_SUCCESS);
+		VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+	}
+}
+
+/**
+ *
+ * @brief Test latency of signature verification in loaded system
+ *
+ * This function tests the latency of signature verification.  To simulate
+ * the loading of a normal system, constant signature generations are performed
+ * in parallel with the signature verifications.
+ *
+ */
+void test_sigVerifLatencyLoaded(void)
+{
+	test_sigVerifLatency(LOADED_TEST);
+}
+
+/**
+ *
+ * @brief Test latency of signature verification in unloaded system
+ *
+ * This function tests the latency of signature verification in an unloaded
+ * system.  Only the signature verification is running when measuring the
+ * latency.
+ *
+ */
+void test_sigVerifLatencyUnloaded(void)
+{
+	test_sigVerifLatency(UNLOADED_TEST);
+}
+
+/**
+ * @brief   Signature verification callback: open loop latency tests
+ *
+ * @param[in]  sequence_number       request slot of the operation
+ * @param[out] ret                   returned value by the dispatcher
+ * @param[out] verification_result   verification result
+ *
+ */
+static void signatureVerificationCallback_openLoop(void *sequence_number,
+	int ret,
+	ecdsa_verification_result_t verification_result)
+{
+	vtestAsyncReq_t req;
+
+	/* Latency is measured from scheduled send time in request slot */
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
+
+	/* Record latency, log end time on last verification */
+	vtestHistRecord(&latencyHist, req.nsLatency);
+	pthread_mutex_lock(&loopLock);
+	if ((--loopsPending == 0) &&
+			(clock_gettime(CLOCK_BOOTTIME, &endTime) == -1))
+		VTEST_FLAG_CONF();
+	pthread_mutex_unlock(&loopLock);
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief   Add a number of ns to a timespec struct
+ *
+ * @param time timespec to update
+ * @param ns number of ns to add
+ *
+ */
+static void addTimeNs(struct timespec *time, long ns)
+{
+	time->tv_sec += ns / 1000000000;
+	time->tv_nsec += ns % 1000000000;
+	if (time->tv_nsec >= 1000000000) {
+		time->tv_sec++;
+		time->tv_nsec -= 1000000000;
+	}
+}
+
+/**
+ * @brief   Get the interval to the next scheduled operation
+ *
+ * @param arrivalType OPEN_LOOP_FIXED_RATE or OPEN_LOOP_POISSON
+ * @param nsPeriod mean interval between operations, in ns
+ * @param seed seed for the random generator, updated on each call
+ *
+ * @return interval in ns
+ *
+ */
+static long nextArrivalNs(uint32_t arrivalType, long nsPeriod,
+							unsigned int *seed)
+{
+	double uniform;
+
+	if (arrivalType == OPEN_LOOP_FIXED_RATE)
+		return nsPeriod;
+
+	/* Poisson process: exponentially distributed intervals */
+	uniform = (rand_r(seed) + 1.0) / (RAND_MAX + 2.0);
+	return (long)(-log(uniform) * nsPeriod);
+}
+
+/**
+ * @brief   Fill in rate and latency percentiles of an open loop run
+ *
+ * @param result run result to update
+ *
+ */
+static void setLoadStepResult(TypeLoadStepResult_t *result)
+{
+	long nsTimeDiff;
+
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	if (nsTimeDiff > 0)
+		result->achievedRate = latencyHist.count * 1000000000 /
+								nsTimeDiff;
+	result->p50Ns = vtestHistPercentile(&latencyHist, 50.0f);
+	result->p99Ns = vtestHistPercentile(&latencyHist, 99.0f);
+	result->maxNs = latencyHist.max;
+}
+
+/**
+ * @brief   Run open loop signature verification load
+ *
+ * Sends numVerifs signature verifications on a schedule independent of
+ * the completion of previous verifications, and records the latency of
+ * each from its scheduled send time.  If all request slots are in use,
+ * the system cannot keep up with the offered rate: no more verifications
+ * are sent and the run ends early.  Test data must be populated with
+ * TEST_TYPE_SIG_VERIF_RATE, and ecdsa library opened.
+ *
+ * @param arrivalType OPEN_LOOP_FIXED_RATE or OPEN_LOOP_POISSON
+ * @param rate offered verification rate, in verifs/sec
+ * @param numVerifs number of verifications to send
+ * @param result measured rates and latencies of the run
+ *
+ * @return number of verifications sent
+ *
+ */
+static long runSigVerifOpenLoop(uint32_t arrivalType, long rate,
+				long numVerifs, TypeLoadStepResult_t *result)
+{
+	struct timespec sendTime;
+	struct timespec currTime;
+	unsigned int seed = SIG_VERIF_OPEN_LOOP_SEED;
+	ecdsa_pubkey_t pubkey;
+	ecdsa_sig_t sig;
+	void *req;
+	long nsPeriod = 1000000000 / rate;
+	long nsLag;
+	long sent;
+	int idx;
+
+	memset(result, 0, sizeof(*result));
+	result->offeredRate = rate;
+	vtestHistReset(&latencyHist);
+	loopsPending = numVerifs;
+
+	/* First verification is scheduled now */
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	sendTime = startTime;
+
+	for (sent = 0; sent < numVerifs; sent++) {
+		/* Wait for scheduled send time, don't wait if late */
+		clock_nanosleep(CLOCK_BOOTTIME, TIMER_ABSTIME, &sendTime, NULL);
+		if (clock_gettime(CLOCK_BOOTTIME, &currTime) == -1) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+		CALCULATE_TIME_DIFF_NS(sendTime, currTime, nsLag);
+		if (nsLag > result->maxLagNs)
+			result->maxLagNs = nsLag;
+
+		/* Too many verifications in flight means system overloaded */
+		req = vtestAsyncReqIssueAt(&count_async, ASYNC_OP_VERIF_MSG,
+				ECDSA_VERIFICATION_SUCCESS, &sendTime);
+		if (!req)
+			break;
+
+		idx = sent % SIG_RATE_VERIF_NUM;
+		pubkey.x = pubKeyArray[idx % NUM_KEYS_PERF_TESTS].x;
+		pubkey.y = pubKeyArray[idx % NUM_KEYS_PERF_TESTS].y;
+		sig.r = sigArray[idx].r;
+		sig.s = sigArray[idx].s;
+		VTEST_CHECK_RESULT_ASYNC_INC(
+			ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
+				pubkey, msgArray[idx].data,
+				sizeof(msgArray[idx].data), sig, 0,
+				signatureVerificationCallback_openLoop, req),
+			ECDSA_NO_ERROR, count_async);
+
+		addTimeNs(&sendTime, nextArrivalNs(arrivalType, nsPeriod,
+								&seed));
+	}
+
+	/* Wait for remaining verifications */
+	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, ASYNC_LOOP_TIMEOUT);
+
+	/* Last callback only logs end time if all verifications were sent */
+	if (loopsPending && (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1)) {
+		VTEST_FLAG_CONF();
+		return sent;
+	}
+	setLoadStepResult(result);
+
+	return sent;
+}
+
+/**
+ *
+ * @brief Test latency of signature verification under open loop load.
+ *
+ * This function sends signature verifications on a fixed schedule,
+ * independent of the completion of previous verifications, at the rate
+ * generated by SIG_VERIF_OPEN_LOOP_VEHICLES_* vehicles each sending
+ * SIG_VERIF_OPEN_LOOP_MSG_HZ messages per second.  Intervals between
+ * verifications are either constant, or exponentially distributed (Poisson
+ * arrivals).  Latency is measured from the scheduled send time of each
+ * verification, so queueing delay and late sends are part of the result.
+ * The p99 latency is compared to the signature verification latency
+ * requirement.
+ *
+ * @param arrivalType OPEN_LOOP_FIXED_RATE or OPEN_LOOP_POISSON
+ *
+ */
+void test_sigVerifLatencyOpenLoop(uint32_t arrivalType)
+{
+	TypeLoadStepResult_t result;
+	long numVehicles;
+	long sent;
+
+#if LEGACY_SECO_LIBS
+	if (seco_os_abs_has_v2x_hw())
+#else
+	if (plat_os_abs_has_v2x_hw())
+#endif
+		numVehicles = SIG_VERIF_OPEN_LOOP_VEHICLES_V2XFW;
+	else
+		numVehicles = SIG_VERIF_OPEN_LOOP_VEHICLES_SECOFW;
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_VERIF_RATE))
+		return;
+
+	/* Set up system for signature verification */
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+	sent = runSigVerifOpenLoop(arrivalType,
+			numVehicles * SIG_VERIF_OPEN_LOOP_MSG_HZ,
+			SIG_RATE_VERIF_NUM, &result);
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+
+	/* All verifications must be sent for a valid result */
+	VTEST_CHECK_RESULT(sent, SIG_RATE_VERIF_NUM);
+	if (!loopsPending && (latencyHist.count == SIG_RATE_VERIF_NUM)) {
+		VTEST_LOG("Open loop load: %ld vehicles at %d Hz, %s arrivals,"
+			" offered %ld verifs/sec, achieved %ld verifs/sec\n",
+			numVehicles, SIG_VERIF_OPEN_LOOP_MSG_HZ,
+			(arrivalType == OPEN_LOOP_FIXED_RATE) ?
+			"fixed rate" : "Poisson",
+			result.offeredRate, result.achievedRate);
+		VTEST_LOG("Max send lag behind schedule: %.2f ms\n",
+					result.maxLagNs / (float)1000000);
+		vtestHistLog(&latencyHist, "Sig verif");
+		VTEST_LOG("Allowed sig verif latency: %.2f ms at p99\n",
+						SIG_VERIF_LATENCY_THRESHOLD);
+
+		/* Compare to requirement */
+		VTEST_CHECK_RESULT(result.p99Ns / (float)1000000 >
+					SIG_VERIF_LATENCY_THRESHOLD, 0);
+	}
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_VERIF_RATE);
+}
+
+/**
+ *
+ * @brief Test latency of signature verification under fixed rate load
+ *
+ * This function tests the latency of signature verification, with
+ * verifications sent at a constant rate independent of their completion.
+ *
+ */
+void test_sigVerifLatencyOpenLoopFixed(void)
+{
+	test_sigVerifLatencyOpenLoop(OPEN_LOOP_FIXED_RATE);
+}
+
+/**
+ *
+ * @brief Test latency of signature verification under Poisson load
+ *
+ * This function tests the latency of signature verification, with
+ * verifications sent with Poisson arrivals independent of their completion.
+ *
+ */
+void test_sigVerifLatencyOpenLoopPoisson(void)
+{
+	test_sigVerifLatencyOpenLoop(OPEN_LOOP_POISSON);
+}
+
+/**
+ * @brief   Check if a load step did not keep up with the offered rate
+ *
+ * @param result measured result of the load step
+ * @param numOps number of operations the load step should have sent
+ * @param sent number of operations actually sent
+ *
+ * @return 1 if saturated, 0 otherwise
+ *
+ */
+static int loadStepSaturated(TypeLoadStepResult_t *result, long numOps,
+								long sent)
+{
+	if (sent < numOps)
+		return 1;
+	return (result->achievedRate * 100 < result->offeredRate *
+					(100 - SIG_KNEE_SATURATION_PCT));
+}
+
+/**
+ * @brief   Log results of a load sweep and find the knee
+ *
+ * The knee is the highest offered rate the system kept up with.  The
+ * SLO rate is the highest offered rate of a step that kept up with it
+ * with p99 latency within the latency requirement: unlike the achieved
+ * rate, it does not depend on the random arrival times of the step.
+ *
+ * @param result results of each load step
+ * @param numSteps number of load steps run
+ * @param sloMs p99 latency requirement in ms
+ * @param unit name of operation for log messages
+ *
+ * @return max offered rate within latency SLO, 0 if none
+ *
+ */
+static long reportLoadSweep(TypeLoadStepResult_t *result, int numSteps,
+						float sloMs, char *unit)
+{
+	long kneeRate = 0;
+	long sloRate = 0;
+	int i;
+
+	VTEST_LOG("Offered    Achieved   p50 ms   p99 ms   max ms   (%s/sec)\n",
+									unit);
+	for (i = 0; i < numSteps; i++) {
+		VTEST_LOG("%-10ld %-10ld %-8.2f %-8.2f %-8.2f %s\n",
+				result[i].offeredRate,
+				result[i].achievedRate,
+				result[i].p50Ns / (float)1000000,
+				result[i].p99Ns / (float)1000000,
+				result[i].maxNs / (float)1000000,
+				result[i].saturated ? "saturated" : "");
+		if (result[i].saturated)
+			continue;
+		kneeRate = result[i].offeredRate;
+		if ((result[i].p99Ns / (float)1000000 <= sloMs) &&
+				(result[i].offeredRate > sloRate))
+			sloRate = result[i].offeredRate;
+	}
+	VTEST_LOG("Saturation knee: %ld %s/sec offered\n", kneeRate, unit);
+	VTEST_LOG("Max rate with p99 within %.2f ms: %ld %s/sec offered\n",
+							sloMs, sloRate, unit);
+	return sloRate;
+}
+
+/**
+ *
+ * @brief Find the throughput/latency knee of signature verification
+ *
+ * This function runs open loop signature verification load at increasing
+ * offered rates, in steps of SIG_KNEE_STEP_PCT % of the verification rate
+ * requirement, until the achieved rate falls behind the offered rate.  The
+ * saturation knee and the max rate meeting the latency requirement at p99
+ * are reported.  The rate meeting the latency requirement is compared to
+ * the rate requirement.
+ *
+ */
+void test_sigVerifKnee(void)
+{
+	TypeLoadStepResult_t result[SIG_KNEE_STEPS];
+	long threshold = sigVerifRateThreshold();
+	long sloRate;
+	long sent;
+	int numSteps;
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_VERIF_RATE))
+		return;
+
+	/* Step up offered load until system stops keeping up */
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+	for (numSteps = 0; numSteps < SIG_KNEE_STEPS; ) {
+		sent = runSigVerifOpenLoop(OPEN_LOOP_POISSON, threshold *
+				SIG_KNEE_STEP_PCT * (numSteps + 1) / 100,
+				SIG_KNEE_VERIF_NUM, &result[numSteps]);
+		result[numSteps].saturated = loadStepSaturated(
+				&result[numSteps], SIG_KNEE_VERIF_NUM, sent);
+		if (result[numSteps++].saturated)
+			break;
+	}
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+
+	sloRate = reportLoadSweep(result, numSteps,
+				SIG_VERIF_LATENCY_THRESHOLD, "verifs");
+	VTEST_LOG("Signature verification rate requirement: %ld verifs/sec\n",
+								threshold);
+
+	/* Compare to requirement */
+	VTEST_CHECK_RESULT(sloRate < threshold, 0);
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_VERIF_RATE);
+}
+
+/**
+ * @brief   Run open loop signature generation load
+ *
+ * Generates signatures on a schedule at the offered rate.  Signature
+ * generation is synchronous, so each signature is started at its scheduled
+ * time, or as soon as the previous one completes if late.  Latency is
+ * measured from the scheduled time, so time spent waiting for previous
+ * signatures is included.  If signatures fall more than SIG_KNEE_MAX_LAG_MS
+ * behind schedule, the system cannot keep up and the run ends early.
+ * Test data must be populated with TEST_TYPE_SIG_GEN_RATE, and the system
+ * in ACTIVATED state.
+ *
+ * @param rate offered signature generation rate, in sigs/sec
+ * @param numSigs number of signatures to generate
+ * @param result measured rates and latencies of the run
+ *
+ * @return number of signatures generated
+ *
+ */
+static long runSigGenOpenLoop(long rate, long numSigs,
+						TypeLoadStepResult_t *result)
+{
+	TypeSW_t statusCode;
+	TypeSignature_t signature;
+	struct timespec sendTime;
+	struct timespec currTime;
+	long nsPeriod = 1000000000 / rate;
+	long nsLag;
+	long nsLatency;
+	long sent;
+
+	memset(result, 0, sizeof(*result));
+	result->offeredRate = rate;
+	vtestHistReset(&latencyHist);
+
+	/* First signature is scheduled now */
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	sendTime = startTime;
+
+	for (sent = 0; sent < numSigs; sent++) {
+		/* Wait for scheduled time, don't wait if late */
+		clock_nanosleep(CLOCK_BOOTTIME, TIMER_ABSTIME, &sendTime, NULL);
+		if (clock_gettime(CLOCK_BOOTTIME, &currTime) == -1) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+		CALCULATE_TIME_DIFF_NS(sendTime, currTime, nsLag);
+		if (nsLag > result->maxLagNs)
+			result->maxLagNs = nsLag;
+		if (nsLag > SIG_KNEE_MAX_LAG_MS * 1000000l)
+			break;
+
+		VTEST_CHECK_RESULT(v2xSe_createRtSign(sent % NUM_KEYS_PERF_TESTS,
+				&hashArray[sent % SIG_RATE_GEN_NUM],
+				&statusCode, &signature), V2XSE_SUCCESS);
+
+		if (clock_gettime(CLOCK_BOOTTIME, &currTime) == -1) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+		CALCULATE_TIME_DIFF_NS(sendTime, currTime, nsLatency);
+		vtestHistRecord(&latencyHist, nsLatency);
+		addTimeNs(&sendTime, nsPeriod);
+	}
+
+	endTime = currTime;
+	setLoadStepResult(result);
+
+	return sent;
+}
+
+/**
+ *
+ * @brief Find the throughput/latency knee of signature generation
+ *
+ * This function generates signatures at increasing offered rates, in steps
+ * of SIG_KNEE_STEP_PCT % of the signature generation rate requirement,
+ * until the achieved rate falls behind the offered rate.  The saturation
+ * knee and the max rate meeting the latency requirement at p99 are
+ * reported.  The rate meeting the latency requirement is compared to the
+ * rate requirement.
+ *
+ */
+void test_sigGenKnee(void)
+{
+	TypeLoadStepResult_t result[SIG_KNEE_STEPS];
+	long sloRate;
+	long sent;
+	int numSteps;
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_GEN_RATE))
+		return;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+
+	/* Step up offered load until system stops keeping up */
+	for (numSteps = 0; numSteps < SIG_KNEE_STEPS; ) {
+		sent = runSigGenOpenLoop(SIG_GEN_RATE_THRESHOLD *
+				SIG_KNEE_STEP_PCT * (numSteps + 1) / 100,
+				SIG_KNEE_GEN_NUM, &result[numSteps]);
+		result[numSteps].saturated = loadStepSaturated(
+				&result[numSteps], SIG_KNEE_GEN_NUM, sent);
+		if (result[numSteps++].saturated)
+			break;
+	}
+
+	sloRate = reportLoadSweep(result, numSteps, SIG_GEN_LATENCY_THRESHOLD,
+									"sigs");
+	VTEST_LOG("Signature generation rate requirement: %d sigs/sec\n",
+						SIG_GEN_RATE_THRESHOLD);
+
+	/* Compare to requirement */
+	VTEST_CHECK_RESULT(sloRate < SIG_GEN_RATE_THRESHOLD, 0);
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_GEN_RATE);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/**
+ * @brief   Start signature verifications in the background
+ *
+ * Verifications are launched one after the other from their callback, to
+ * simulate a loaded system during signature generation tests, until
+ * numVerifs are done or stopBackgroundVerif is called.
+ *
+ * @param numVerifs max number of verifications
+ *
+ */
+static void startBackgroundVerif(int numVerifs)
+{
+	/* Set up for parallel signature verification */
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+	/* The count will be forced to 0 at the end to stop the test */
+	loopCount = numVerifs;
+	/*
+	 * Use canned hash, key & sig for parallel sig verif.
+	 * Performance of sig verif operations not measured so don't
+	 * care about possible cache effects of always using same data.
+	 */
+	verif_hash = (ecdsa_hash_t)cannedHash.data;
+	verif_pubkey.x = cannedPubkeyNIST256_X;
+	verif_pubkey.y = cannedPubkeyNIST256_Y;
+	verif_sig.r = cannedSigNIST256_R;
+	verif_sig.s = cannedSigNIST256_S;
+
+	/* Start parallel signature verification */
+	VTEST_CHECK_RESULT_ASYNC_INC(
+		ecdsa_verify_signature(ECDSA_CURVE_NISTP256, verif_pubkey,
+			verif_hash, verif_sig, 0,
+			signatureVerificationCallback_background,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_HASH)),
+		ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief   Stop signature verifications started by startBackgroundVerif
+ *
+ */
+static void stopBackgroundVerif(void)
+{
+	/* Stop parallel signature verification */
+	loopCount = 0;
+	/* Clean up - loops should be finished soon */
+	VTEST_CHECK_RESULT_ASYNC_WAIT(count_async, TIME_UNIT_10_MS);
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+}
+
+/**
+ *
+ * @brief Test latency of signature generation.
+ *
+ * This function tests the latency of signature generation.  If requested,
+ * simulation of a loaded system is done using constant signature verifications
+ * in parallel with the signature generations.
+ *
+ * @param testType indicates whether test should run on loaded system or not
+ *
+ */
+void test_sigGenLatency(uint32_t testType)
+{
+	TypeSW_t statusCode;
+	TypeSignature_t signature;
+	int32_t i;
+	long nsLatency;
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_GEN_LATENCY))
+		return;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+
+	/*
+	 * Assume sig verif is not 10 times faster than sig gen, so loop
+	 * count below will keep the verifs running during the whole test.
+	 */
+	if (testType == LOADED_TEST)
+		startBackgroundVerif(SIG_LATENCY_GEN_NUM * 10);
+
+	/* Clear latencies before first measurement */
+	vtestHistReset(&latencyHist);
+
+	/* Loop to generate the signatures */
+	for (i = 0; i < SIG_LATENCY_GEN_NUM; i++) {
+		/* Get start time */
+		if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+			VTEST_FLAG_CONF();
+			goto stopGenLatencyTest;
+		}
+		/* Generate the signature */
+		VTEST_CHECK_RESULT(v2xSe_createRtSign(i % NUM_KEYS_PERF_TESTS,
+				&hashArray[i],	&statusCode, &signature),
+				V2XSE_SUCCESS);
+		/* Get end time */
+		if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
+			VTEST_FLAG_CONF();
+			goto stopGenLatencyTest;
+		}
+
+		/* Calculate latency */
+		CALCULATE_TIME_DIFF_NS(startTime, endTime, nsLatency);
+		vtestHistRecord(&latencyHist, nsLatency);
+	}
+
+	checkLatency(&latencyHist, "Sig gen", SIG_GEN_LATENCY_THRESHOLD);
+
+stopGenLatencyTest:
+	if (testType == LOADED_TEST)
+		stopBackgroundVerif();
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_GEN_LATENCY);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/**
+ *
+ * @brief Test latency of signature generation in a loaded system
+ *
+ * This function tests the latency of signature generation in a loaded
+ * system. Simulation of a loaded system is done using constant signature
+ * verifications in parallel with the signature generations.
+ *
+ */
+void test_sigGenLatencyLoaded(void)
+{
+	test_sigGenLatency(LOADED_TEST);
+}
+
+/**
+ *
+ * @brief Test latency of signature generation in an unloaded system
+ *
+ * This function tests the latency of signature generation in an unloaded
+ * system. Only the signature generation is performed when the latency is
+ * measured.
+ *
+ */
+void test_sigGenLatencyUnloaded(void)
+{
+	test_sigGenLatency(UNLOADED_TEST);
+}
+
+/** Start jitters measured by the periodic signature test, in ns */
+static vtestHist_t jitterHist;
+
+/**
+ *
+ * @brief Test periodic signature generation against a deadline
+ *
+ * This function generates signatures on a periodic timer, as for periodic
+ * safety messages, for each period of SIG_PERIODIC_PERIODS_MS.  For each
+ * signature, the start jitter (from scheduled release to start of the
+ * call) and completion latency (from scheduled release to end of the call)
+ * are recorded, and a deadline miss is counted if the signature completes
+ * more than SIG_PERIODIC_DEADLINE_MS after release.  If requested,
+ * signature verifications run in the background as in the latency tests.
+ *
+ * @param testType indicates whether test should run on loaded system or not
+ *
+ */
+void test_sigGenPeriodic(uint32_t testType)
+{
+	static const int periodMs[SIG_PERIODIC_NUM_PERIODS] =
+							SIG_PERIODIC_PERIODS_MS;
+	TypeSW_t statusCode;
+	TypeSignature_t signature;
+	struct timespec releaseTime, sigStart, sigEnd;
+	long nsJitter;
+	long nsLatency;
+	long misses;
+	int period;
+	int i;
+
+	/* Populate data for test */
+	if (populateTestData(TEST_TYPE_SIG_GEN_LATENCY))
+		return;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+
+	if (testType == LOADED_TEST)
+		startBackgroundVerif(INT_MAX);
+
+	for (period = 0; period < SIG_PERIODIC_NUM_PERIODS; period++) {
+		vtestHistReset(&jitterHist);
+		vtestHistReset(&latencyHist);
+		misses = 0;
+
+		if (clock_gettime(CLOCK_BOOTTIME, &releaseTime) == -1) {
+			VTEST_FLAG_CONF();
+			goto stopPeriodicTest;
+		}
+		for (i = 0; i < SIG_PERIODIC_NUM; i++) {
+			/* Wait for next release of the periodic timer */
+			addTimeNs(&releaseTime, periodMs[period] * 1000000l);
+			clock_nanosleep(CLOCK_BOOTTIME, TIMER_ABSTIME,
+							&releaseTime, NULL);
+			if (clock_gettime(CLOCK_BOOTTIME, &sigStart) == -1) {
+				VTEST_FLAG_CONF();
+				goto stopPeriodicTest;
+			}
+			VTEST_CHECK_RESULT(v2xSe_createRtSign(
+				i % NUM_KEYS_PERF_TESTS, &hashArray[i],
+				&statusCode, &signature), V2XSE_SUCCESS);
+			if (clock_gettime(CLOCK_BOOTTIME, &sigEnd) == -1) {
+				VTEST_FLAG_CONF();
+				goto stopPeriodicTest;
+			}
+
+			CALCULATE_TIME_DIFF_NS(releaseTime, sigStart, nsJitter);
+			CALCULATE_TIME_DIFF_NS(releaseTime, sigEnd, nsLatency);
+			vtestHistRecord(&jitterHist, nsJitter);
+			vtestHistRecord(&latencyHist, nsLatency);
+			if (nsLatency > SIG_PERIODIC_DEADLINE_MS * 1000000l)
+				misses++;
+		}
+
+		VTEST_LOG("Period %d ms, deadline %d ms:\n", periodMs[period],
+						SIG_PERIODIC_DEADLINE_MS);
+		vtestHistLog(&jitterHist, "Start jitter");
+		vtestHistLog(&latencyHist, "Completion");
+		VTEST_LOG("Deadline misses: %ld of %d (max allowed %d)\n",
+			misses, SIG_PERIODIC_NUM, SIG_PERIODIC_MAX_MISSES);
+		VTEST_CHECK_RESULT(misses > SIG_PERIODIC_MAX_MISSES, 0);
+	}
+
+stopPeriodicTest:
+	if (testType == LOADED_TEST)
+		stopBackgroundVerif();
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_GEN_LATENCY);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/**
+ *
+ * @brief Test periodic signature generation in a loaded system
+ *
+ * This function tests periodic signature generation in a loaded system,
+ * with constant signature verifications in parallel.
+ *
+ */
+void test_sigGenPeriodicLoaded(void)
+{
+	test_sigGenPeriodic(LOADED_TEST);
+}
+
+/**
+ *
+ * @brief Test periodic signature generation in an unloaded system
+ *
+ * This function tests periodic signature generation in an unloaded system.
+ *
+ */
+void test_sigGenPeriodicUnloaded(void)
+{
+	test_sigGenPeriodic(UNLOADED_TEST);
+}
+
+
+static uint8_t *message = (uint8_t *)
+"To be, or not to be, that is the question,\n"
+"Whether 'tis nobler in the mind to suffer\n"
+"The slings and arrows of outrageous fortune,\n"
+"Or to take arms against a sea of troubles,\n"
+"And by opposing end them? To die: to sleep;\n"
+"No more; and by a sleep to say we end\n"
+"The heart-ache and the thousand natural shoc\n";
+/** Length of message used for performance tests */
+#define MESSAGE_LEN strlen((char *)message)
+
+static TypeHash_t testHash;
+static uint8_t ecdsa_x[V2XSE_384_EC_PUB_KEY_XY_SIZE];
+static uint8_t ecdsa_y[V2XSE_384_EC_PUB_KEY_XY_SIZE];
+static uint8_t ecdsa_r[V2XSE_384_EC_R_SIGN];
+static uint8_t ecdsa_s[V2XSE_384_EC_S_SIGN];
+static long nVerifs;	/* number of sig verifs performed */
+static long nsSpentVerifs; /* elapsed time since begining of verif test */
+
+/**
+ * @brief Test rate of signature verification
+ *
+ * @param[in]  sequence_number       request slot of the operation
+ * @param[out] ret                   returned value by the ECDSA dispatcher
+ * @param[out] verification_result   verification result
+ *
+ */
+static void signatureVerificationCallback(void *sequence_number,
+	int ret,
+	ecdsa_verification_result_t verification_result)
+{
+	struct timespec currTime;
+	vtestAsyncReq_t req;
+
+	/* One more signature verification performed */
+	nVerifs++;
+
+	/* Check correctness of the verification operation */
+	VTEST_CHECK_RESULT(vtestAsyncReqComplete(&count_async, sequence_number,
+							&req), VTEST_PASS);
+	VTEST_CHECK_RESULT(verification_result, req.expResult);
+
+	/* Check if test duration has been reached */
+	if (clock_gettime(CLOCK_BOOTTIME, &currTime) == -1) {
+		VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
+		return;
+	}
+	CALCULATE_TIME_DIFF_NS(startTime, currTime, nsSpentVerifs);
+	if (nsSpentVerifs >= SIG_GEN_VERIF_TIME_SECONDS * 1e9) {
+		/* Test is over: set loopCount to 0 to terminate the loop */
+		loopCount = 0;
+	} else {
+		/* Perform another signature verification */
+		VTEST_CHECK_RESULT_ASYNC_INC(
+			ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
+				verif_pubkey, message, MESSAGE_LEN, verif_sig, 0,
+				signatureVerificationCallback,
+				REQ_VERIF_PASS(&count_async,
+					ASYNC_OP_VERIF_MSG)),
+			ECDSA_NO_ERROR, count_async);
+	}
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
+}
+
+/**
+ * @brief Test rate of signature verification
+ *
+ * @param ptr not used
+ *
+ */
+static void *verif_thread(void *ptr)
+{
+	long sigVerifRate;
+	long threshold;
+
+	threshold = sigVerifRateThreshold();
+
+	/*
+	 * Count the number of signature verifications that can be perfomed
+	 * during the test duration.
+	 * Counter variable is incremented in the callback function.
+	 */
+	nVerifs = 0;
+	loopCount = 100000000;
+	/*
+	 * loopCount: number of signatures high enough not to be reached.
+	 *            Time elapsed will be used to stop the verification loop.
+	 */
+	/* Perform signature verification */
+	VTEST_CHECK_RESULT_ASYNC_INC(
+		ecdsa_verify_signature_of_message(ECDSA_CURVE_NISTP256,
+			verif_pubkey, message, MESSAGE_LEN, verif_sig, 0,
+			signatureVerificationCallback,
+			REQ_VERIF_PASS(&count_async, ASYNC_OP_VERIF_MSG)),
+		ECDSA_NO_ERROR, count_async);
+
+	/* Wait for signature verification loop completion */
+	VTEST_CHECK_RESULT_ASYNC_LOOP(count_async, loopCount);
+
+	VTEST_LOG("Elapsed time for %ld signature verifications: %ld ms\n",
+			nVerifs, nsSpentVerifs / 1000000);
+	sigVerifRate = nVerifs * 1000000000 / nsSpentVerifs;
+	VTEST_LOG("Signature verification rate: %ld verifs/sec (expect %d)\n",
+			sigVerifRate, threshold);
+
+	/* Compare to signature verification requirement */
+	VTEST_CHECK_RESULT(sigVerifRate < threshold, 0);
+
+	return NULL;
+}
+
+/**
+ *
+ * @brief Test rate of signature generation / verification
+ *
+ * This function starts a thread to test the following in parallel:
+ * o signature generation rate
+ * o signature verification rate
+ *
+ */
+void test_sigGenVerifRate(void)
+{
+	int ret;
+	long n, nsSpent, sigGenRate;
+	pthread_t thread_verif;
+	TypeSW_t hsmStatusCode;
+	TypePublicKey_t pubKey;
+	TypeSignature_t signature;
+	struct timespec currTime;
+
+	VTEST_RETURN_CONF_IF_NO_V2X_HW();
+
+	/* Set up pub key and signature structures for ECDSA verifications */
+	verif_pubkey.x = ecdsa_x;
+	verif_pubkey.y = ecdsa_y;
+	verif_sig.r    = ecdsa_r;
+	verif_sig.s    = ecdsa_s;
+
+	/* Use ECDSA to verify signature */
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+
+	/* Generate ECC key pair */
+	VTEST_CHECK_RESULT(v2xSe_generateRtEccKeyPair(SLOT_ZERO,
+			V2XSE_CURVE_NISTP256, &hsmStatusCode, &pubKey),
+		V2XSE_SUCCESS);
+
+#ifndef ECC_PATTERNS_BIG_ENDIAN
+	/* Convert public key for ECSDA verification */
+	convertEndianness(pubKey.x, ecdsa_x, V2XSE_256_EC_PUB_KEY_XY_SIZE);
+	convertEndianness(pubKey.y, ecdsa_y, V2XSE_256_EC_PUB_KEY_XY_SIZE);
+#else
+	memcpy(ecdsa_x, pubKey.x, V2XSE_256_EC_PUB_KEY_XY_SIZE);
+	memcpy(ecdsa_y, pubKey.y, V2XSE_256_EC_PUB_KEY_XY_SIZE);
+#endif
+
+	/* Calculate digest value of test message */
+	VTEST_CHECK_RESULT(ecdsa_sha256(message, MESSAGE_LEN, testHash.data),
+			ECDSA_NO_ERROR);
+
+	/* Calculate a signature to feed the verification thread */
+	VTEST_CHECK_RESULT(v2xSe_createRtSign(SLOT_ZERO,
+			&testHash, &hsmStatusCode, &signature),
+			V2XSE_SUCCESS);
+
+#ifndef ECC_PATTERNS_BIG_ENDIAN
+	/* Convert signature for ECDSA verification */
+	convertEndianness(signature.r, ecdsa_r, V2XSE_256_EC_R_SIGN);
+	convertEndianness(signature.s, ecdsa_s, V2XSE_256_EC_S_SIGN);
+#else
+	memcpy(ecdsa_r, signature.r, V2XSE_256_EC_R_SIGN);
+	memcpy(ecdsa_s, signature.s, V2XSE_256_EC_S_SIGN);
+#endif
+
+	/* Get test starting time */
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		goto end;
+	}
+
+	/* Create signature verification thread */
+	ret = pthread_create(&thread_verif, NULL, verif_thread, NULL);
+	if (ret) {
+		VTEST_LOG("Could not create thread for signature verification\n");
+		VTEST_FLAG_CONF();
+		goto end;
+	}
+
+	/*
+	 * Count the number of signature generations that can be perfomed during
+	 * the test duration.
+	 */
+	n = 0;
+	do {
+		/* Perform a signature generation */
+		VTEST_CHECK_RESULT(v2xSe_createRtSign(SLOT_ZERO,
+				&testHash, &hsmStatusCode, &signature),
+				V2XSE_SUCCESS);
+		n++;
+
+		if (clock_gettime(CLOCK_BOOTTIME, &currTime) == -1) {
+			VTEST_FLAG_CONF();
+			goto end;
+		}
+		CALCULATE_TIME_DIFF_NS(startTime, currTime, nsSpent);
+	} while (nsSpent < SIG_GEN_VERIF_TIME_SECONDS * 1e9);
+
+	VTEST_LOG("Elapsed time for %ld signature generations: %ld ms\n",
+			n, nsSpent / 1000000);
+	sigGenRate = n * 1000000000 / nsSpent;
+	VTEST_LOG("Signature generation rate: %ld gens/sec (expect %d)\n",
+			sigGenRate, SIG_GEN_RATE_THRESHOLD);
+
+	/* Compare to signature generation requirement */
+	VTEST_CHECK_RESULT(sigGenRate < SIG_GEN_RATE_THRESHOLD, 0);
+
+	/* Wait for verification thread's completion */
+	pthread_join(thread_verif, NULL);
+
+end:
+	/* Delete key after use */
+	VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(SLOT_ZERO,
+				&hsmStatusCode), V2XSE_SUCCESS);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+
+	/* Close ecdsa session */
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+}
+
+/** State of one worker thread of the v2xSe API contention test */
+typedef struct {
+	/** Thread handle */
+	pthread_t thread;
+	/** API called by the thread, one of SE_OP_* */
+	int op;
+	/** Rt key slot used by the thread */
+	TypeRtKeyId_t slot;
+	/** Number of API calls completed */
+	long numCalls;
+} TypeSeWorker_t;
+
+/** Worker threads of the v2xSe API contention test */
+static TypeSeWorker_t seWorkers[SE_CONTENTION_MAX_THREADS];
+/** Latencies of each API measured by the contention test, in ns */
+static vtestHist_t seOpHist[SE_CONTENTION_NUM_OPS];
+/** Public key used for ECIES encryption in the contention test */
+static TypePublicKey_t seContentionPubKey;
+/** Message encrypted in the contention test */
+static TypePlainText_t seContentionMsg;
+/** ECIES KDF parameter P1, 32 bytes as in the ECIES functional tests */
+static uint8_t eciesP1[32] = {	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+				0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+				0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+				0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37
+				};
+/** Set to stop the worker threads */
+static volatile int stopSeWorkers;
+/** Names of the APIs called in the contention test, for log messages */
+static char *seOpName[SE_CONTENTION_NUM_OPS] = {
+	"createRtSign",
+	"getRandomNumber",
+	"getRtEccPublicKey",
+	"encryptUsingEcies"
+};
+
+/**
+ * @brief   Call one v2xSe API for the contention test
+ *
+ * @param worker worker state, gives API and key slot to use
+ *
+ * @return value returned by the API
+ *
+ */
+static int32_t callSeOp(TypeSeWorker_t *worker)
+{
+	TypeSW_t statusCode;
+	TypeSignature_t signature;
+	TypeRandomNumber_t rnd;
+	TypePublicKey_t pubKey;
+	TypeCurveId_t curveId;
+	TypeEncryptEcies_t eciesData;
+	TypeVCTData_t vct;
+	TypeLen_t size;
+
+	switch (worker->op) {
+	case SE_OP_CREATE_RT_SIGN:
+		return v2xSe_createRtSign(worker->slot, &cannedHash,
+						&statusCode, &signature);
+	case SE_OP_GET_RANDOM:
+		return v2xSe_getRandomNumber(SE_CONTENTION_RND_SIZE,
+						&statusCode, &rnd);
+	case SE_OP_GET_RT_PUBKEY:
+		return v2xSe_getRtEccPublicKey(worker->slot, &statusCode,
+						&curveId, &pubKey);
+	case SE_OP_ENCRYPT_ECIES:
+	default:
+		eciesData.pEccPublicKey = &seContentionPubKey;
+		eciesData.curveId = V2XSE_CURVE_NISTP256;
+		eciesData.kdfParamP1Len = sizeof(eciesP1);
+		memcpy(eciesData.kdfParamP1, eciesP1, sizeof(eciesP1));
+		eciesData.macLen = 16;
+		eciesData.macParamP2Len = 0;
+		eciesData.msgLen = 16;
+		eciesData.pMsgData = &seContentionMsg;
+		size = sizeof(vct);
+		return v2xSe_encryptUsingEcies(&eciesData, &statusCode,
+							&size, &vct);
+	}
+}
+
+/**
+ * @brief   Worker thread of the v2xSe API contention test
+ *
+ * Calls its API in a loop until stopSeWorkers is set, recording the
+ * latency of each call.
+ *
+ * @param arg worker state of the thread
+ *
+ * @return NULL
+ *
+ */
+static void *seContentionWorker(void *arg)
+{
+	TypeSeWorker_t *worker = arg;
+	struct timespec callStart;
+	struct timespec callEnd;
+	long nsLatency;
+
+	while (!stopSeWorkers) {
+		if (clock_gettime(CLOCK_BOOTTIME, &callStart) == -1) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+		VTEST_CHECK_RESULT(callSeOp(worker), V2XSE_SUCCESS);
+		if (clock_gettime(CLOCK_BOOTTIME, &callEnd) == -1) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+		CALCULATE_TIME_DIFF_NS(callStart, callEnd, nsLatency);
+		vtestHistRecord(&seOpHist[worker->op], nsLatency);
+		worker->numCalls++;
+	}
+	return NULL;
+}
+
+/**
+ * @brief   Run v2xSe API calls from several threads in parallel
+ *
+ * Runs numThreads worker threads for SE_CONTENTION_SECONDS, thread i
+ * calling API ops[i] with Rt key slot i.  Latencies of each API are
+ * recorded in seOpHist and the number of calls of each thread in
+ * seWorkers.
+ *
+ * @param ops API called by each thread, SE_OP_*
+ * @param numThreads number of worker threads
+ *
+ * @return aggregate rate of all threads in calls/sec, or 0 on failure
+ *
+ */
+static long runSeContention(const int *ops, int numThreads)
+{
+	long nsTimeDiff;
+	long total = 0;
+	int numStarted;
+	int i;
+
+	for (i = 0; i < SE_CONTENTION_NUM_OPS; i++)
+		vtestHistReset(&seOpHist[i]);
+	stopSeWorkers = 0;
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	for (numStarted = 0; numStarted < numThreads; numStarted++) {
+		seWorkers[numStarted].op = ops[numStarted];
+		seWorkers[numStarted].slot = numStarted;
+		seWorkers[numStarted].numCalls = 0;
+		if (pthread_create(&seWorkers[numStarted].thread, NULL,
+				seContentionWorker, &seWorkers[numStarted])) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+	}
+
+	sleep(SE_CONTENTION_SECONDS);
+
+	stopSeWorkers = 1;
+	for (i = 0; i < numStarted; i++) {
+		pthread_join(seWorkers[i].thread, NULL);
+		total += seWorkers[i].numCalls;
+	}
+	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	if (numStarted < numThreads)
+		return 0;
+
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	return total * 1000000000 / nsTimeDiff;
+}
+
+/**
+ *
+ * @brief Profile contention between v2xSe API calls from several threads
+ *
+ * This function first calls each of v2xSe_createRtSign (each thread using
+ * its own key slot), v2xSe_getRandomNumber, v2xSe_getRtEccPublicKey and
+ * v2xSe_encryptUsingEcies from 1, 2, 4... SE_CONTENTION_MAX_THREADS
+ * threads, reporting the throughput scaling and latency of each.  Then
+ * all APIs are called in parallel, one thread each, and the latency of
+ * each API is compared to its latency when called alone.  This shows
+ * whether the v2xSe layer serializes calls, and the cost of sharing the
+ * SE between signing and certificate management threads.
+ *
+ */
+void test_seApiContention(void)
+{
+	TypeSW_t statusCode;
+	TypePublicKey_t pubKey;
+	int ops[SE_CONTENTION_MAX_THREADS];
+	long aloneRate[SE_CONTENTION_NUM_OPS];
+	long aloneP50[SE_CONTENTION_NUM_OPS];
+	long rate;
+	int numThreads;
+	int op;
+	int i;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+
+	/* Create an Rt key for each thread */
+	for (i = 0; i < SE_CONTENTION_MAX_THREADS; i++) {
+		VTEST_CHECK_RESULT(v2xSe_generateRtEccKeyPair(i,
+			V2XSE_CURVE_NISTP256, &statusCode, &pubKey),
+							V2XSE_SUCCESS);
+		if (!i)
+			seContentionPubKey = pubKey;
+	}
+
+	/* Throughput scaling of each API called alone */
+	for (op = 0; op < SE_CONTENTION_NUM_OPS; op++) {
+		for (i = 0; i < SE_CONTENTION_MAX_THREADS; i++)
+			ops[i] = op;
+		aloneRate[op] = 0;
+		aloneP50[op] = 0;
+		for (numThreads = 1; numThreads <= SE_CONTENTION_MAX_THREADS;
+							numThreads *= 2) {
+			rate = runSeContention(ops, numThreads);
+			if (!rate)
+				goto stopContentionTest;
+			if (numThreads == 1) {
+				aloneRate[op] = rate;
+				aloneP50[op] = vtestHistPercentile(&seOpHist[op],
+									50.0f);
+			}
+			VTEST_LOG("%s, %d threads: %ld calls/sec (x%.2f),"
+				" %.2f ms p50, %.2f ms p99\n", seOpName[op],
+				numThreads, rate, rate / (float)aloneRate[op],
+				vtestHistPercentile(&seOpHist[op], 50.0f) /
+								(float)1000000,
+				vtestHistPercentile(&seOpHist[op], 99.0f) /
+								(float)1000000);
+		}
+	}
+
+	/* All APIs in parallel, one thread each */
+	for (op = 0; op < SE_CONTENTION_NUM_OPS; op++)
+		ops[op] = op;
+	rate = runSeContention(ops, SE_CONTENTION_NUM_OPS);
+	if (!rate)
+		goto stopContentionTest;
+	VTEST_LOG("All APIs in parallel: %ld calls/sec\n", rate);
+	for (op = 0; op < SE_CONTENTION_NUM_OPS; op++)
+		VTEST_LOG("%s in parallel: %ld calls/sec (%ld alone),"
+			" %.2f ms p50 (x%.2f alone), %.2f ms p99\n",
+			seOpName[op], seWorkers[op].numCalls /
+			SE_CONTENTION_SECONDS, aloneRate[op],
+			vtestHistPercentile(&seOpHist[op], 50.0f) /
+							(float)1000000,
+			vtestHistPercentile(&seOpHist[op], 50.0f) /
+							(float)aloneP50[op],
+			vtestHistPercentile(&seOpHist[op], 99.0f) /
+							(float)1000000);
+
+stopContentionTest:
+	/* Delete keys after use */
+	for (i = 0; i < SE_CONTENTION_MAX_THREADS; i++)
+		VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(i,
+					&statusCode), V2XSE_SUCCESS);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/** State of one thread of the hash benchmark */
+typedef struct {
+	/** Thread handle */
+	pthread_t thread;
+	/** Hash function to call, one of HASH_BENCH_* */
+	int hashType;
+	/** Data hashed by the thread */
+	uint8_t *data;
+	/** Size of data hashed per call */
+	size_t size;
+	/** Number of calls to make */
+	long numCalls;
+} TypeHashWorker_t;
+
+/** Threads of the hash benchmark */
+static TypeHashWorker_t hashWorkers[HASH_BENCH_MAX_THREADS];
+/** Names of the hash functions of the hash benchmark, for log messages */
+static char *hashBenchName[HASH_BENCH_NUM_TYPES] = {
+	"SHA-256",
+	"SHA-384",
+	"SM3"
+};
+
+/**
+ * @brief   Call one ecdsa library hash function
+ *
+ * @param hashType hash function to call, one of HASH_BENCH_*
+ * @param data data to hash
+ * @param size size of data to hash
+ * @param digest buffer for the hash, big enough for SHA-384
+ *
+ * @return value returned by the hash function
+ *
+ */
+static int callHashFn(int hashType, const uint8_t *data, size_t size,
+							uint8_t *digest)
+{
+	switch (hashType) {
+	case HASH_BENCH_SHA256:
+		return ecdsa_sha256((const void *)data, size, digest);
+	case HASH_BENCH_SHA384:
+		return ecdsa_sha384((const void *)data, size, digest);
+	case HASH_BENCH_SM3:
+	default:
+		return ecdsa_sm3((const void *)data, size, digest);
+	}
+}
+
+/**
+ * @brief   Thread of the hash benchmark
+ *
+ * Hashes its data numCalls times, recording the latency of each call in
+ * latencyHist.
+ *
+ * @param arg state of the thread
+ *
+ * @return NULL
+ *
+ */
+static void *hashBenchWorker(void *arg)
+{
+	TypeHashWorker_t *worker = arg;
+	uint8_t digest[V2XSE_384_EC_HASH_SIZE];
+	struct timespec callStart;
+	struct timespec callEnd;
+	long nsLatency;
+	long i;
+
+	for (i = 0; i < worker->numCalls; i++) {
+		if (clock_gettime(CLOCK_BOOTTIME, &callStart) == -1) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+		VTEST_CHECK_RESULT(callHashFn(worker->hashType, worker->data,
+				worker->size, digest), ECDSA_NO_ERROR);
+		if (clock_gettime(CLOCK_BOOTTIME, &callEnd) == -1) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+		CALCULATE_TIME_DIFF_NS(callStart, callEnd, nsLatency);
+		vtestHistRecord(&latencyHist, nsLatency);
+	}
+	return NULL;
+}
+
+/**
+ * @brief   Measure hash throughput from several threads
+ *
+ * Each thread hashes HASH_BENCH_BYTES bytes of its own data, in calls of
+ * size bytes.  The latency of each call is recorded in latencyHist.
+ *
+ * @param hashType hash function to call, one of HASH_BENCH_*
+ * @param data data to hash, size bytes for each thread
+ * @param size size of data hashed per call
+ * @param numThreads number of threads
+ *
+ * @return aggregate throughput in MB/s, or 0 on failure
+ *
+ */
+static float runHashBench(int hashType, uint8_t *data, size_t size,
+							int numThreads)
+{
+	long nsTimeDiff;
+	int numStarted;
+	int i;
+
+	vtestHistReset(&latencyHist);
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	for (numStarted = 0; numStarted < numThreads; numStarted++) {
+		hashWorkers[numStarted].hashType = hashType;
+		hashWorkers[numStarted].data = data + numStarted * size;
+		hashWorkers[numStarted].size = size;
+		hashWorkers[numStarted].numCalls = HASH_BENCH_BYTES / size;
+		if (pthread_create(&hashWorkers[numStarted].thread, NULL,
+				hashBenchWorker, &hashWorkers[numStarted])) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+	}
+	for (i = 0; i < numStarted; i++)
+		pthread_join(hashWorkers[i].thread, NULL);
+	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	if (numStarted < numThreads)
+		return 0;
+
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	return latencyHist.count * size * 1000 / (float)nsTimeDiff;
+}
+
+/**
+ *
+ * @brief Test throughput of the ecdsa library hash functions
+ *
+ * This function measures ecdsa_sha256, ecdsa_sha384 and ecdsa_sm3 for
+ * message sizes from HASH_BENCH_MIN_SIZE to HASH_BENCH_MAX_SIZE, from 1,
+ * 2... HASH_BENCH_MAX_THREADS threads.  The aggregate throughput and the
+ * latency of each call are reported, to show whether hashing received
+ * messages on the host is a bottleneck before the ECC verification.  SM3
+ * is only measured with V2X HW.
+ *
+ */
+void test_hashRate(void)
+{
+	uint8_t *hashData;
+	float mbPerSec;
+	size_t size;
+	int hasV2xHw;
+	int numThreads;
+	int hashType;
+
+#if LEGACY_SECO_LIBS
+	hasV2xHw = seco_os_abs_has_v2x_hw();
+#else
+	hasV2xHw = plat_os_abs_has_v2x_hw();
+#endif
+
+	hashData = malloc(HASH_BENCH_MAX_THREADS * HASH_BENCH_MAX_SIZE);
+	VTEST_CHECK_RESULT((!hashData), 0);
+	if (!hashData)
+		return;
+
+	/* Random data to hash, from SE random number generator */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+	VTEST_CHECK_RESULT(fillRandomData(hashData, HASH_BENCH_MAX_THREADS *
+					HASH_BENCH_MAX_SIZE), VTEST_PASS);
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+
+	VTEST_CHECK_RESULT(ecdsa_open(), ECDSA_NO_ERROR);
+	VTEST_LOG("Hash     Size (B)  Threads  MB/s      p50 us    p99 us\n");
+	for (hashType = 0; hashType < HASH_BENCH_NUM_TYPES; hashType++) {
+		if ((hashType == HASH_BENCH_SM3) && !hasV2xHw)
+			continue;
+		for (size = HASH_BENCH_MIN_SIZE; size <= HASH_BENCH_MAX_SIZE;
+								size *= 4) {
+			for (numThreads = 1;
+					numThreads <= HASH_BENCH_MAX_THREADS;
+							numThreads *= 2) {
+				mbPerSec = runHashBench(hashType, hashData,
+							size, numThreads);
+				if (!mbPerSec)
+					goto stopHashTest;
+				VTEST_LOG("%-8s %-9zu %-8d %-9.1f %-9.2f %.2f\n",
+					hashBenchName[hashType], size,
+					numThreads, mbPerSec,
+					vtestHistPercentile(&latencyHist,
+							50.0f) / 1000.0f,
+					vtestHistPercentile(&latencyHist,
+							99.0f) / 1000.0f);
+			}
+		}
+	}
+
+stopHashTest:
+	VTEST_CHECK_RESULT(ecdsa_close(), ECDSA_NO_ERROR);
+	free(hashData);
+}
+
+/** Set to stop the signing thread of the key derivation test */
+static volatile int stopDerivSigning;
+/** Number of signatures generated by the key derivation signing thread */
+static long derivNumSigs;
+
+/**
+ * @brief   Signing thread of the key derivation test
+ *
+ * Generates signatures with the Rt keys of the test data back to back,
+ * counting them in derivNumSigs, until stopDerivSigning is set.
+ *
+ * @param arg unused
+ *
+ * @return NULL
+ *
+ */
+static void *derivSigningThread(void *arg)
+{
+	TypeSW_t statusCode;
+	TypeSignature_t signature;
+	long i;
+
+	for (i = 0; !stopDerivSigning; i++) {
+		VTEST_CHECK_RESULT(v2xSe_createRtSign(i % NUM_KEYS_PERF_TESTS,
+			&hashArray[i % SIG_RATE_GEN_NUM], &statusCode,
+			&signature), V2XSE_SUCCESS);
+		__atomic_fetch_add(&derivNumSigs, 1, __ATOMIC_RELAXED);
+	}
+	return NULL;
+}
+
+/**
+ * @brief   Derive a batch of Rt keys into consecutive slots
+ *
+ * Derives numKeys keys from the Ba key in KEY_DERIV_BA_SLOT into the Rt
+ * slots following the keys of the test data, recording the latency of
+ * each derivation in latencyHist, then deletes them, also on failure.
+ * Each key is derived with different expansion values, as for butterfly
+ * keys of successive certificates.
+ *
+ * @param numKeys number of keys to derive
+ * @param numSigs number of signatures generated by the signing thread
+ *                while the keys were derived
+ *
+ * @return derivation rate in keys/sec, or 0 on failure
+ *
+ */
+static long measureKeyDeriv(int numKeys, long *numSigs)
+{
+	TypeSW_t statusCode;
+	TypePublicKey_t pubKey;
+	TypeCurveId_t curveId;
+	TypeInt256_t fvSign;
+	TypeInt256_t rvij;
+	TypeInt256_t hvij;
+	struct timespec keyStart, keyEnd;
+	long nsTimeDiff;
+	long rate = 0;
+	int numDerived = 0;
+	int i;
+
+	memset(&fvSign, 0, sizeof(fvSign));
+	memset(&rvij, 0, sizeof(rvij));
+	memset(&hvij, 0, sizeof(hvij));
+	fvSign.data[0] = 1;
+
+	vtestHistReset(&latencyHist);
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1)
+		goto fail;
+	*numSigs = __atomic_load_n(&derivNumSigs, __ATOMIC_RELAXED);
+	for (i = 0; i < numKeys; i++) {
+		/* Expansion values of certificate i */
+		rvij.data[0] = 2;
+		rvij.data[1] = i >> 8;
+		rvij.data[2] = i & 0xff;
+		hvij.data[0] = 3;
+		hvij.data[1] = i >> 8;
+		hvij.data[2] = i & 0xff;
+		if (clock_gettime(CLOCK_BOOTTIME, &keyStart) == -1)
+			goto fail;
+		VTEST_CHECK_RESULT(v2xSe_deriveRtEccKeyPair(KEY_DERIV_BA_SLOT,
+			&fvSign, &rvij, &hvij, NUM_KEYS_PERF_TESTS + i,
+			V2XSE_RSP_WITH_PUBKEY, &statusCode, &curveId, &pubKey),
+			V2XSE_SUCCESS);
+		numDerived++;
+		if (clock_gettime(CLOCK_BOOTTIME, &keyEnd) == -1)
+			goto fail;
+		CALCULATE_TIME_DIFF_NS(keyStart, keyEnd, nsTimeDiff);
+		vtestHistRecord(&latencyHist, nsTimeDiff);
+	}
+	endTime = keyEnd;
+	*numSigs = __atomic_load_n(&derivNumSigs, __ATOMIC_RELAXED) - *numSigs;
+
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	rate = numKeys * 1000000000l / nsTimeDiff;
+	goto exit;
+
+fail:
+	VTEST_FLAG_CONF();
+exit:
+	/* Delete keys after use */
+	for (i = 0; i < numDerived; i++)
+		VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(
+			NUM_KEYS_PERF_TESTS + i, &statusCode), V2XSE_SUCCESS);
+	return rate;
+}
+
+/**
+ *
+ * @brief Test rate of butterfly key derivation in batches
+ *
+ * This function derives KEY_DERIV_BATCH_NUM Rt keys (one week of
+ * pseudonym certificates) from a Ba key into consecutive Rt slots with
+ * v2xSe_deriveRtEccKeyPair, as after a pseudonym certificate download.
+ * The batch is derived alone, then while another thread generates
+ * signatures, to show the effect of concurrent signing.  The derivation
+ * rate and latency distribution are reported for both cases.
+ *
+ */
+void test_keyDerivRate(void)
+{
+	TypeSW_t statusCode;
+	TypePublicKey_t pubKey;
+	TypeInformation_t seInfo;
+	pthread_t signingThread;
+	long rate;
+	long numSigs;
+	long nsTimeDiff;
+	int numKeys;
+	int signing;
+
+	/* Populate data for test, Rt keys and hashes for signing thread */
+	if (populateTestData(TEST_TYPE_SIG_GEN_RATE))
+		return;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+	/* Limit batch to Rt slots available after the test data keys */
+	VTEST_CHECK_RESULT(v2xSe_getSeInfo(&statusCode, &seInfo),
+								V2XSE_SUCCESS);
+	numKeys = MIN(KEY_DERIV_BATCH_NUM,
+			seInfo.maxRtKeysAllowed - NUM_KEYS_PERF_TESTS);
+	/* Generate Ba key to use in derivation */
+	VTEST_CHECK_RESULT(v2xSe_generateBaEccKeyPair(KEY_DERIV_BA_SLOT,
+		V2XSE_CURVE_NISTP256, &statusCode, &pubKey), V2XSE_SUCCESS);
+
+	for (signing = 0; signing <= 1; signing++) {
+		if (signing) {
+			stopDerivSigning = 0;
+			derivNumSigs = 0;
+			if (pthread_create(&signingThread, NULL,
+					derivSigningThread, NULL)) {
+				VTEST_FLAG_CONF();
+				break;
+			}
+		}
+		rate = measureKeyDeriv(numKeys, &numSigs);
+		if (signing) {
+			stopDerivSigning = 1;
+			pthread_join(signingThread, NULL);
+		}
+		if (!rate)
+			break;
+
+		VTEST_LOG("Derived %d keys%s: %ld keys/sec\n", numKeys,
+				signing ? " with concurrent signing" : "",
+				rate);
+		vtestHistLog(&latencyHist, "Key derivation");
+		if (signing) {
+			CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+			VTEST_LOG("Concurrent signing: %ld sig/sec\n",
+				numSigs * 1000000000l / nsTimeDiff);
+		}
+	}
+
+	/* Delete key after use */
+	VTEST_CHECK_RESULT(v2xSe_deleteBaEccPrivateKey(KEY_DERIV_BA_SLOT,
+						&statusCode), V2XSE_SUCCESS);
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_GEN_RATE);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/** Key change to first signature latencies of pseudonym churn test */
+static vtestHist_t churnChangeHist;
+/** Old key deletion latencies of pseudonym churn test */
+static vtestHist_t churnDeleteHist;
+
+/**
+ * @brief   Run pseudonym change cycles at a given rate
+ *
+ * Each cycle creates a key in the next of PSEUDO_CHURN_SLOTS rotating Rt
+ * slots (after the keys of the test data), generates the first signature
+ * with it, then deletes the key of the previous cycle.  The first
+ * signature latency is recorded in latencyHist, the time from start of
+ * key change to first signature in churnChangeHist and the deletion
+ * latency in churnDeleteHist.  Keys still present are deleted before
+ * returning, also on failure.
+ *
+ * @param derive set to derive keys from the Ba key in KEY_DERIV_BA_SLOT,
+ *               instead of generating them
+ * @param rateHz cycles started per second, 0 to run cycles back to back
+ *
+ * @return achieved cycle rate in cycles/sec, or 0 on failure
+ *
+ */
+static long runPseudonymChurn(int derive, int rateHz)
+{
+	TypeSW_t statusCode;
+	TypePublicKey_t pubKey;
+	TypeSignature_t signature;
+	TypeCurveId_t curveId;
+	TypeInt256_t fvSign;
+	TypeInt256_t rvij;
+	TypeInt256_t hvij;
+	struct timespec releaseTime, changeStart, sigStart, sigEnd, delEnd;
+	long nsTimeDiff;
+	long rate = 0;
+	/* Slots of keys of current and previous pseudonym, -1 if none */
+	int newSlot = -1;
+	int oldSlot = -1;
+	int slot;
+	int i;
+
+	memset(&fvSign, 0, sizeof(fvSign));
+	memset(&rvij, 0, sizeof(rvij));
+	memset(&hvij, 0, sizeof(hvij));
+	fvSign.data[0] = 1;
+
+	vtestHistReset(&latencyHist);
+	vtestHistReset(&churnChangeHist);
+	vtestHistReset(&churnDeleteHist);
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1)
+		goto fail;
+	releaseTime = startTime;
+	for (i = 0; i < PSEUDO_CHURN_CYCLES; i++) {
+		if (rateHz) {
+			/* Wait for next pseudonym change */
+			clock_nanosleep(CLOCK_BOOTTIME, TIMER_ABSTIME,
+							&releaseTime, NULL);
+			addTimeNs(&releaseTime, 1000000000l / rateHz);
+		}
+		slot = NUM_KEYS_PERF_TESTS + i % PSEUDO_CHURN_SLOTS;
+		oldSlot = newSlot;
+		newSlot = -1;
+
+		/* Create key of new pseudonym */
+		if (clock_gettime(CLOCK_BOOTTIME, &changeStart) == -1)
+			goto fail;
+		if (derive) {
+			rvij.data[0] = hvij.data[0] = 2;
+			rvij.data[1] = hvij.data[1] = i >> 8;
+			rvij.data[2] = hvij.data[2] = i & 0xff;
+			VTEST_CHECK_RESULT(v2xSe_deriveRtEccKeyPair(
+				KEY_DERIV_BA_SLOT, &fvSign, &rvij, &hvij, slot,
+				V2XSE_RSP_WITH_PUBKEY, &statusCode, &curveId,
+				&pubKey), V2XSE_SUCCESS);
+		} else {
+			VTEST_CHECK_RESULT(v2xSe_generateRtEccKeyPair(slot,
+				V2XSE_CURVE_NISTP256, &statusCode, &pubKey),
+				V2XSE_SUCCESS);
+		}
+		newSlot = slot;
+
+		/* First signature with new pseudonym */
+		if (clock_gettime(CLOCK_BOOTTIME, &sigStart) == -1)
+			goto fail;
+		VTEST_CHECK_RESULT(v2xSe_createRtSign(slot,
+			&hashArray[i % SIG_RATE_GEN_NUM], &statusCode,
+			&signature), V2XSE_SUCCESS);
+		if (clock_gettime(CLOCK_BOOTTIME, &sigEnd) == -1)
+			goto fail;
+
+		/* Delete key of old pseudonym */
+		if (oldSlot >= 0) {
+			VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(oldSlot,
+						&statusCode), V2XSE_SUCCESS);
+			oldSlot = -1;
+		}
+		if (clock_gettime(CLOCK_BOOTTIME, &delEnd) == -1)
+			goto fail;
+
+		CALCULATE_TIME_DIFF_NS(sigStart, sigEnd, nsTimeDiff);
+		vtestHistRecord(&latencyHist, nsTimeDiff);
+		CALCULATE_TIME_DIFF_NS(changeStart, sigEnd, nsTimeDiff);
+		vtestHistRecord(&churnChangeHist, nsTimeDiff);
+		if (i > 0) {
+			CALCULATE_TIME_DIFF_NS(sigEnd, delEnd, nsTimeDiff);
+			vtestHistRecord(&churnDeleteHist, nsTimeDiff);
+		}
+	}
+	endTime = delEnd;
+
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	rate = PSEUDO_CHURN_CYCLES * 1000000000l / nsTimeDiff;
+	goto exit;
+
+fail:
+	VTEST_FLAG_CONF();
+exit:
+	/* Delete keys of pseudonyms still present */
+	if (oldSlot >= 0)
+		VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(oldSlot,
+						&statusCode), V2XSE_SUCCESS);
+	if (newSlot >= 0)
+		VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(newSlot,
+						&statusCode), V2XSE_SUCCESS);
+	return rate;
+}
+
+/**
+ *
+ * @brief Test pseudonym change churn
+ *
+ * This function models pseudonym changes: cycles of key creation, first
+ * signature with the new key and deletion of the old key, over rotating
+ * Rt slots.  Keys are generated, then derived from a Ba key, with cycles
+ * started at each rate of PSEUDO_CHURN_RATES_HZ (0 for back to back).
+ * The cycle throughput, first signature latency and time from key change
+ * to first signature are reported, with their worst case.
+ *
+ */
+void test_pseudonymChurn(void)
+{
+	static const int rateHz[PSEUDO_CHURN_NUM_RATES] =
+							PSEUDO_CHURN_RATES_HZ;
+	TypeSW_t statusCode;
+	TypePublicKey_t pubKey;
+	long cycleRate;
+	int derive;
+	int rate;
+
+	/* Populate data for test, hashes to sign */
+	if (populateTestData(TEST_TYPE_SIG_GEN_RATE))
+		return;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+	/* Generate Ba key to use in derivation */
+	VTEST_CHECK_RESULT(v2xSe_generateBaEccKeyPair(KEY_DERIV_BA_SLOT,
+		V2XSE_CURVE_NISTP256, &statusCode, &pubKey), V2XSE_SUCCESS);
+
+	VTEST_LOG("Key       Rate Hz  cycles/sec  Sig p99 ms  Sig max ms"
+		"  Change p99 ms  Change max ms  Delete max ms\n");
+	for (derive = 0; derive <= 1; derive++) {
+		for (rate = 0; rate < PSEUDO_CHURN_NUM_RATES; rate++) {
+			cycleRate = runPseudonymChurn(derive, rateHz[rate]);
+			if (!cycleRate)
+				goto stopChurnTest;
+			VTEST_LOG("%-9s %-8d %-11ld %-11.2f %-11.2f %-14.2f"
+				" %-14.2f %.2f\n",
+				derive ? "derived" : "generated", rateHz[rate],
+				cycleRate,
+				vtestHistPercentile(&latencyHist, 99.0f) /
+								(float)1000000,
+				latencyHist.max / (float)1000000,
+				vtestHistPercentile(&churnChangeHist, 99.0f) /
+								(float)1000000,
+				churnChangeHist.max / (float)1000000,
+				churnDeleteHist.max / (float)1000000);
+		}
+	}
+
+stopChurnTest:
+	/* Delete key after use */
+	VTEST_CHECK_RESULT(v2xSe_deleteBaEccPrivateKey(KEY_DERIV_BA_SLOT,
+						&statusCode), V2XSE_SUCCESS);
+
+	/* Free allocated data */
+	freeTestData(TEST_TYPE_SIG_GEN_RATE);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/** Names of key classes measured by ECIES benchmark */
+static char *eciesKeyName[ECIES_BENCH_NUM_KEY_CLASSES] = {
+	"Rt",
+	"Ba",
+	"Ma",
+};
+/** Names of encryption schemes measured by ECIES benchmark */
+static char *eciesSchemeName[ECIES_BENCH_NUM_SCHEMES] = {
+	"ECIES",
+	"SM2 ECES",
+};
+/** Encryption latencies of ECIES benchmark */
+static vtestHist_t eciesEncHist;
+/** Plaintext messages of ECIES benchmark */
+static TypePlainText_t eciesBenchMsg[ECIES_BENCH_NUM];
+/** Ciphertexts of ECIES benchmark, sized for ECIES VCT or SM2 ECES */
+static uint8_t eciesBenchCt[ECIES_BENCH_NUM][MAX(sizeof(TypeVCTData_t),
+			sizeof(TypePlainText_t) + SM2_PKE_OVERHEAD + 4)];
+/** Ciphertext lengths of ECIES benchmark */
+static TypeLen_t eciesBenchCtLen[ECIES_BENCH_NUM];
+/** Message sizes measured by ECIES benchmark */
+static size_t eciesBenchSize[ECIES_BENCH_MAX_SIZES];
+/** Number of message sizes measured by ECIES benchmark */
+static int eciesBenchNumSizes;
+/** Encryption rates of ECIES benchmark, by scheme, key class and size */
+static long eciesEncRate[ECIES_BENCH_NUM_SCHEMES][ECIES_BENCH_NUM_KEY_CLASSES]
+							[ECIES_BENCH_MAX_SIZES];
+/** Decryption rates of ECIES benchmark, by scheme, key class and size */
+static long eciesDecRate[ECIES_BENCH_NUM_SCHEMES][ECIES_BENCH_NUM_KEY_CLASSES]
+							[ECIES_BENCH_MAX_SIZES];
+
+/**
+ * @brief   Encrypt one message of the ECIES benchmark
+ *
+ * @param scheme encryption scheme to use, ECIES_SCHEME_xxx
+ * @param pubKey public key of recipient
+ * @param msg message to encrypt
+ * @param msgSize size of message to encrypt, in bytes
+ * @param ctLen length of ciphertext, also input buffer size
+ * @param ct buffer for ciphertext
+ *
+ * @return value returned by the API
+ *
+ */
+static int32_t callEciesEncrypt(int scheme, TypePublicKey_t *pubKey,
+			TypePlainText_t *msg, TypeLen_t msgSize,
+			TypeLen_t *ctLen, uint8_t *ct)
+{
+	TypeSW_t statusCode;
+	TypeEncryptEcies_t eciesData;
+	TypeEncryptSm2Eces_t sm2EcesData;
+
+	if (scheme == ECIES_SCHEME_SM2_ECES) {
+		sm2EcesData.pEccPublicKey = pubKey;
+		sm2EcesData.curveId = V2XSE_CURVE_SM2_256;
+		sm2EcesData.msgLen = msgSize;
+		sm2EcesData.pMsgData = msg;
+		return v2xSe_encryptUsingSm2Eces(&sm2EcesData, &statusCode,
+								ctLen, ct);
+	}
+
+	eciesData.pEccPublicKey = pubKey;
+	eciesData.curveId = V2XSE_CURVE_NISTP256;
+	eciesData.kdfParamP1Len = sizeof(eciesP1);
+	memcpy(eciesData.kdfParamP1, eciesP1, sizeof(eciesP1));
+	eciesData.macLen = ECIES_BENCH_MAC_LEN;
+	eciesData.macParamP2Len = 0;
+	eciesData.msgLen = msgSize;
+	eciesData.pMsgData = msg;
+	return v2xSe_encryptUsingEcies(&eciesData, &statusCode, ctLen,
+							(TypeVCTData_t *)ct);
+}
+
+/**
+ * @brief   Decrypt one ciphertext of the ECIES benchmark
+ *
+ * @param scheme encryption scheme to use, ECIES_SCHEME_xxx
+ * @param keyClass class of key to decrypt with, ECIES_KEY_xxx
+ * @param slot key slot to use for Rt and Ba keys
+ * @param ct ciphertext to decrypt
+ * @param ctLen length of ciphertext
+ * @param msgLen length of decrypted message, also input buffer size
+ * @param msg buffer for decrypted message
+ *
+ * @return value returned by the API
+ *
+ */
+static int32_t callEciesDecrypt(int scheme, int keyClass, int slot,
+			uint8_t *ct, TypeLen_t ctLen, TypeLen_t *msgLen,
+			TypePlainText_t *msg)
+{
+	TypeSW_t statusCode;
+	TypeDecryptEcies_t eciesData;
+	TypeDecryptSm2Eces_t sm2EcesData;
+
+	if (scheme == ECIES_SCHEME_SM2_ECES) {
+		sm2EcesData.encryptedDataSize = ctLen;
+		sm2EcesData.encryptedData = ct;
+		switch (keyClass) {
+		case ECIES_KEY_RT:
+			return v2xSe_decryptUsingRtSm2Eces(slot, &sm2EcesData,
+						&statusCode, msgLen, msg);
+		case ECIES_KEY_BA:
+			return v2xSe_decryptUsingBaSm2Eces(slot, &sm2EcesData,
+						&statusCode, msgLen, msg);
+		case ECIES_KEY_MA:
+		default:
+			return v2xSe_decryptUsingMaSm2Eces(&sm2EcesData,
+						&statusCode, msgLen, msg);
+		}
+	}
+
+	eciesData.kdfParamP1Len = sizeof(eciesP1);
+	memcpy(eciesData.kdfParamP1, eciesP1, sizeof(eciesP1));
+	eciesData.macLen = ECIES_BENCH_MAC_LEN;
+	eciesData.macParamP2Len = 0;
+	eciesData.vctLen = ctLen;
+	eciesData.pVctData = (TypeVCTData_t *)ct;
+	switch (keyClass) {
+	case ECIES_KEY_RT:
+		return v2xSe_decryptUsingRtEcies(slot, &eciesData, &statusCode,
+								msgLen, msg);
+	case ECIES_KEY_BA:
+		return v2xSe_decryptUsingBaEcies(slot, &eciesData, &statusCode,
+								msgLen, msg);
+	case ECIES_KEY_MA:
+	default:
+		return v2xSe_decryptUsingMaEcies(&eciesData, &statusCode,
+								msgLen, msg);
+	}
+}
+
+/**
+ * @brief   Measure encryption and decryption of one message size
+ *
+ * Encrypts ECIES_BENCH_NUM random messages of msgSize bytes, rotating
+ * over the recipient keys (key slot i % numKeys), then decrypts each
+ * ciphertext with the matching private key and checks the result.
+ * Encryption latencies are recorded in eciesEncHist, decryption
+ * latencies in latencyHist.
+ *
+ * @param scheme encryption scheme to use, ECIES_SCHEME_xxx
+ * @param keyClass class of recipient keys, ECIES_KEY_xxx
+ * @param pubKeys public keys of recipients, by key slot
+ * @param numKeys number of recipient keys
+ * @param msgSize size of messages to encrypt, in bytes
+ * @param encRate achieved encryption rate in ops/sec
+ * @param decRate achieved decryption rate in ops/sec
+ *
+ * @return VTEST_PASS or VTEST_FAIL
+ *
+ */
+static int measureEcies(int scheme, int keyClass, TypePublicKey_t *pubKeys,
+			int numKeys, TypeLen_t msgSize, long *encRate,
+			long *decRate)
+{
+	TypePlainText_t msg;
+	TypeLen_t msgLen;
+	struct timespec opStart, opEnd;
+	long nsTimeDiff;
+	long nsTotal;
+	int i;
+
+	for (i = 0; i < ECIES_BENCH_NUM; i++)
+		if (fillRandomData(eciesBenchMsg[i].data, msgSize))
+			return VTEST_FAIL;
+
+	/* Encrypt all messages, rotating over recipients */
+	vtestHistReset(&eciesEncHist);
+	nsTotal = 0;
+	for (i = 0; i < ECIES_BENCH_NUM; i++) {
+		eciesBenchCtLen[i] = sizeof(eciesBenchCt[i]);
+		if (clock_gettime(CLOCK_BOOTTIME, &opStart) == -1)
+			goto fail;
+		if (callEciesEncrypt(scheme, &pubKeys[i % numKeys],
+				&eciesBenchMsg[i], msgSize,
+				&eciesBenchCtLen[i], eciesBenchCt[i])) {
+			VTEST_LOG("Error encrypting %d byte message\n",
+								msgSize);
+			return VTEST_FAIL;
+		}
+		if (clock_gettime(CLOCK_BOOTTIME, &opEnd) == -1)
+			goto fail;
+		CALCULATE_TIME_DIFF_NS(opStart, opEnd, nsTimeDiff);
+		vtestHistRecord(&eciesEncHist, nsTimeDiff);
+		nsTotal += nsTimeDiff;
+	}
+	*encRate = ECIES_BENCH_NUM * 1000000000l / nsTotal;
+
+	/* Decrypt all ciphertexts with matching private key */
+	vtestHistReset(&latencyHist);
+	nsTotal = 0;
+	for (i = 0; i < ECIES_BENCH_NUM; i++) {
+		msgLen = sizeof(msg);
+		if (clock_gettime(CLOCK_BOOTTIME, &opStart) == -1)
+			goto fail;
+		if (callEciesDecrypt(scheme, keyClass, i % numKeys,
+				eciesBenchCt[i], eciesBenchCtLen[i], &msgLen,
+				&msg)) {
+			VTEST_LOG("Error decrypting %d byte message\n",
+								msgSize);
+			return VTEST_FAIL;
+		}
+		if (clock_gettime(CLOCK_BOOTTIME, &opEnd) == -1)
+			goto fail;
+		CALCULATE_TIME_DIFF_NS(opStart, opEnd, nsTimeDiff);
+		vtestHistRecord(&latencyHist, nsTimeDiff);
+		nsTotal += nsTimeDiff;
+
+		/* Verify message is correctly decrypted */
+		if ((msgLen != msgSize) || (memcmp(msg.data,
+			eciesBenchMsg[i].data, msgSize) != MEMCMP_IDENTICAL)) {
+			VTEST_LOG("Decrypted %d byte message does not match\n",
+								msgSize);
+			return VTEST_FAIL;
+		}
+	}
+	*decRate = ECIES_BENCH_NUM * 1000000000l / nsTotal;
+	return VTEST_PASS;
+
+fail:
+	VTEST_FLAG_CONF();
+	return VTEST_FAIL;
+}
+
+/**
+ * @brief   Run ECIES benchmark over all message sizes for one key class
+ *
+ * Message sizes double from ECIES_BENCH_MIN_SIZE up to the largest
+ * plaintext the API accepts, which is always measured.  Rates are
+ * stored in eciesEncRate and eciesDecRate for later comparison.
+ *
+ * @param scheme encryption scheme to use, ECIES_SCHEME_xxx
+ * @param keyClass class of recipient keys, ECIES_KEY_xxx
+ * @param pubKeys public keys of recipients, by key slot
+ * @param numKeys number of recipient keys
+ *
+ */
+static void runEciesSizes(int scheme, int keyClass, TypePublicKey_t *pubKeys,
+								int numKeys)
+{
+	size_t maxSize = sizeof(TypePlainText_t);
+	size_t msgSize = ECIES_BENCH_MIN_SIZE;
+	long *encRate;
+	long *decRate;
+	int status;
+	int size;
+
+	for (size = 0; size < ECIES_BENCH_MAX_SIZES; size++) {
+		eciesBenchSize[size] = msgSize;
+		eciesBenchNumSizes = size + 1;
+		encRate = &eciesEncRate[scheme][keyClass][size];
+		decRate = &eciesDecRate[scheme][keyClass][size];
+		status = measureEcies(scheme, keyClass, pubKeys, numKeys,
+						msgSize, encRate, decRate);
+		VTEST_CHECK_RESULT(status, VTEST_PASS);
+		if (status != VTEST_PASS)
+			return;
+		VTEST_LOG("%-8s %-4s %-5d %-7zu %-9ld %-11.2f %-11.2f %-9ld"
+			" %-11.2f %-11.2f %.2f\n",
+			eciesSchemeName[scheme], eciesKeyName[keyClass],
+			numKeys, msgSize, *encRate,
+			vtestHistPercentile(&eciesEncHist, 50.0f) /
+							(float)1000000,
+			vtestHistPercentile(&eciesEncHist, 99.0f) /
+							(float)1000000,
+			*decRate,
+			vtestHistPercentile(&latencyHist, 50.0f) /
+							(float)1000000,
+			vtestHistPercentile(&latencyHist, 99.0f) /
+							(float)1000000,
+			latencyHist.max / (float)1000000);
+		if (msgSize == maxSize)
+			break;
+		msgSize = MIN(msgSize * 2, maxSize);
+	}
+}
+
+/**
+ * @brief   Run ECIES benchmark of one scheme for all key classes
+ *
+ * Rt ciphertexts are addressed to ECIES_BENCH_RT_SLOTS recipient keys
+ * in rotation.  The Ma key is measured last, as its creation needs a
+ * phase reset.  The system is left in init state.
+ *
+ * @param scheme encryption scheme to use, ECIES_SCHEME_xxx
+ *
+ */
+static void runEciesScheme(int scheme)
+{
+	TypeSW_t statusCode;
+	TypePublicKey_t pubKeys[ECIES_BENCH_RT_SLOTS];
+	appletSelection_t applet;
+	TypeCurveId_t curveId;
+	int i;
+
+	if (scheme == ECIES_SCHEME_SM2_ECES) {
+		applet = e_CN;
+		curveId = V2XSE_CURVE_SM2_256;
+	} else {
+		applet = e_EU;
+		curveId = V2XSE_CURVE_NISTP256;
+	}
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(applet), VTEST_PASS);
+
+	/* Rt keys, several recipient slots */
+	for (i = 0; i < ECIES_BENCH_RT_SLOTS; i++)
+		VTEST_CHECK_RESULT(v2xSe_generateRtEccKeyPair(i, curveId,
+			&statusCode, &pubKeys[i]), V2XSE_SUCCESS);
+	runEciesSizes(scheme, ECIES_KEY_RT, pubKeys, ECIES_BENCH_RT_SLOTS);
+	for (i = 0; i < ECIES_BENCH_RT_SLOTS; i++)
+		VTEST_CHECK_RESULT(v2xSe_deleteRtEccPrivateKey(i, &statusCode),
+								V2XSE_SUCCESS);
+
+	/* Ba key */
+	VTEST_CHECK_RESULT(v2xSe_generateBaEccKeyPair(SLOT_ZERO, curveId,
+			&statusCode, &pubKeys[0]), V2XSE_SUCCESS);
+	runEciesSizes(scheme, ECIES_KEY_BA, pubKeys, 1);
+	VTEST_CHECK_RESULT(v2xSe_deleteBaEccPrivateKey(SLOT_ZERO,
+						&statusCode), V2XSE_SUCCESS);
+
+	/* Ma key, reset phase to allow its creation */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+	VTEST_CHECK_RESULT(removeNvmVariable((applet == e_CN) ?
+			CN_PHASE_FILENAME : EU_PHASE_FILENAME), VTEST_PASS);
+	VTEST_CHECK_RESULT(setupActivatedNormalState(applet), VTEST_PASS);
+	VTEST_CHECK_RESULT(v2xSe_generateMaEccKeyPair(curveId, &statusCode,
+					&pubKeys[0]), V2XSE_SUCCESS);
+	runEciesSizes(scheme, ECIES_KEY_MA, pubKeys, 1);
+
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/**
+ *
+ * @brief Test rate and latency of ECIES encryption / decryption
+ *
+ * This function measures v2xSe_encryptUsingEcies and the ECIES decryption
+ * with Rt, Ba and Ma keys, over message sizes from ECIES_BENCH_MIN_SIZE
+ * up to the largest plaintext.  Rt ciphertexts are addressed to
+ * ECIES_BENCH_RT_SLOTS recipient keys in rotation.  Each decrypted
+ * message is checked against the original.  Encrypt and decrypt rates
+ * and latency percentiles are reported per key class and message size.
+ *
+ */
+void test_eciesRate(void)
+{
+	VTEST_LOG("Scheme   Key  Keys  Bytes   Enc/sec   Enc p50 ms  Enc p99 ms"
+		"  Dec/sec   Dec p50 ms  Dec p99 ms  Dec max ms\n");
+	runEciesScheme(ECIES_SCHEME_ECIES);
+}
+
+/**
+ *
+ * @brief Test rate and latency of SM2 ECES encryption / decryption
+ *
+ * This function measures v2xSe_encryptUsingSm2Eces and the SM2 ECES
+ * decryption with Rt, Ba and Ma keys, in the same way as the ECIES
+ * benchmark.  ECIES is then measured again on the same hardware, and
+ * the SM2 ECES rates are reported as a ratio of the ECIES rates.
+ *
+ */
+void test_sm2EcesRate(void)
+{
+	int keyClass;
+	int size;
+	long eciesRate;
+	long sm2Rate;
+
+	VTEST_RETURN_CONF_IF_NO_V2X_HW();
+
+	memset(eciesEncRate, 0, sizeof(eciesEncRate));
+	memset(eciesDecRate, 0, sizeof(eciesDecRate));
+	VTEST_LOG("Scheme   Key  Keys  Bytes   Enc/sec   Enc p50 ms  Enc p99 ms"
+		"  Dec/sec   Dec p50 ms  Dec p99 ms  Dec max ms\n");
+	runEciesScheme(ECIES_SCHEME_SM2_ECES);
+	runEciesScheme(ECIES_SCHEME_ECIES);
+
+	VTEST_LOG("\nKey  Bytes   SM2/ECIES enc  SM2/ECIES dec\n");
+	for (keyClass = 0; keyClass < ECIES_BENCH_NUM_KEY_CLASSES;
+								keyClass++) {
+		for (size = 0; size < eciesBenchNumSizes; size++) {
+			VTEST_LOG("%-4s %-7zu", eciesKeyName[keyClass],
+							eciesBenchSize[size]);
+			eciesRate = eciesEncRate[ECIES_SCHEME_ECIES]
+							[keyClass][size];
+			sm2Rate = eciesEncRate[ECIES_SCHEME_SM2_ECES]
+							[keyClass][size];
+			VTEST_LOG(" %-14.2f", eciesRate ?
+					sm2Rate / (float)eciesRate : 0);
+			eciesRate = eciesDecRate[ECIES_SCHEME_ECIES]
+							[keyClass][size];
+			sm2Rate = eciesDecRate[ECIES_SCHEME_SM2_ECES]
+							[keyClass][size];
+			VTEST_LOG(" %.2f\n", eciesRate ?
+					sm2Rate / (float)eciesRate : 0);
+		}
+	}
+}
+
+/** Rt cipher algorithms measured by cipher benchmarks */
+static const int cipherBenchAlgo[CIPHER_BENCH_NUM_ALGOS] = CIPHER_BENCH_ALGOS;
+/** Names of Rt cipher algorithms, for log messages */
+static char *cipherBenchName[CIPHER_BENCH_NUM_ALGOS] = {
+	"SM4-ECB",
+	"SM4-CBC",
+	"SM4-CCM",
+};
+/** Encryption latencies of cipher benchmarks */
+static vtestHist_t cipherEncHist;
+/** Plaintext messages of cipher benchmark */
+static TypePlainText_t cipherBenchMsg[CIPHER_BENCH_NUM];
+/** Ciphertexts of cipher benchmark */
+static TypeVCTData_t cipherBenchCt[CIPHER_BENCH_NUM];
+/** Ciphertext lengths of cipher benchmark */
+static TypeLen_t cipherBenchCtLen[CIPHER_BENCH_NUM];
+
+/**
+ * @brief   Encrypt one buffer with the Rt symmetric key in SLOT_ZERO
+ *
+ * @param algoId cipher algorithm, V2XSE_ALGO_xxx
+ * @param msg data to encrypt
+ * @param msgLen size of data to encrypt, in bytes
+ * @param ct buffer for ciphertext
+ * @param ctLen length of ciphertext, also input buffer size
+ *
+ * @return value returned by the API
+ *
+ */
+static int32_t rtCipherEncrypt(int algoId, uint8_t *msg, TypeLen_t msgLen,
+					TypeVCTData_t *ct, TypeLen_t *ctLen)
+{
+	TypeSW_t statusCode;
+	TypeEncryptCipher_t cipherData;
+
+	memset(cipherData.iv, 0, sizeof(cipherData.iv));
+	cipherData.ivLen = 0;
+	if (algoId == V2XSE_ALGO_SM4_CBC) {
+		memcpy(cipherData.iv, cannedHash.data, CIPHER_BENCH_BLOCK_SIZE);
+		cipherData.ivLen = CIPHER_BENCH_BLOCK_SIZE;
+	}
+	cipherData.algoId = algoId;
+	cipherData.msgLen = msgLen;
+	cipherData.pMsgData = (TypePlainText_t *)msg;
+	return v2xSe_encryptUsingRtCipher(SLOT_ZERO, &cipherData, &statusCode,
+								ctLen, ct);
+}
+
+/**
+ * @brief   Decrypt one buffer with the Rt symmetric key in SLOT_ZERO
+ *
+ * @param algoId cipher algorithm, V2XSE_ALGO_xxx
+ * @param ct ciphertext to decrypt
+ * @param ctLen length of ciphertext
+ * @param msg buffer for decrypted data
+ * @param msgLen length of decrypted data, also input buffer size
+ *
+ * @return value returned by the API
+ *
+ */
+static int32_t rtCipherDecrypt(int algoId, TypeVCTData_t *ct, TypeLen_t ctLen,
+					TypePlainText_t *msg, TypeLen_t *msgLen)
+{
+	TypeSW_t statusCode;
+	TypeDecryptCipher_t cipherData;
+
+	memset(cipherData.iv, 0, sizeof(cipherData.iv));
+	cipherData.ivLen = 0;
+	if (algoId == V2XSE_ALGO_SM4_CBC) {
+		memcpy(cipherData.iv, cannedHash.data, CIPHER_BENCH_BLOCK_SIZE);
+		cipherData.ivLen = CIPHER_BENCH_BLOCK_SIZE;
+	}
+	cipherData.algoId = algoId;
+	cipherData.vctLen = ctLen;
+	cipherData.pVctData = ct;
+	return v2xSe_decryptUsingRtCipher(SLOT_ZERO, &cipherData, &statusCode,
+								msgLen, msg);
+}
+
+/**
+ * @brief   Measure Rt cipher encryption and decryption of one buffer size
+ *
+ * Encrypts CIPHER_BENCH_NUM random buffers of msgSize bytes, then
+ * decrypts each ciphertext and checks the result.  Encryption latencies
+ * are recorded in cipherEncHist, decryption latencies in latencyHist.
+ *
+ * @param algoId cipher algorithm, V2XSE_ALGO_xxx
+ * @param msgSize size of buffers to encrypt, in bytes
+ * @param encMbPerSec achieved encryption throughput in MB/s
+ * @param decMbPerSec achieved decryption throughput in MB/s
+ *
+ * @return VTEST_PASS or VTEST_FAIL
+ *
+ */
+static int measureRtCipher(int algoId, TypeLen_t msgSize, float *encMbPerSec,
+							float *decMbPerSec)
+{
+	TypePlainText_t msg;
+	TypeLen_t msgLen;
+	struct timespec opStart, opEnd;
+	long nsTimeDiff;
+	long nsTotal;
+	int i;
+
+	for (i = 0; i < CIPHER_BENCH_NUM; i++)
+		if (fillRandomData(cipherBenchMsg[i].data, msgSize))
+			return VTEST_FAIL;
+
+	/* Encrypt all buffers */
+	vtestHistReset(&cipherEncHist);
+	nsTotal = 0;
+	for (i = 0; i < CIPHER_BENCH_NUM; i++) {
+		cipherBenchCtLen[i] = sizeof(TypeVCTData_t);
+		if (clock_gettime(CLOCK_BOOTTIME, &opStart) == -1)
+			goto fail;
+		if (rtCipherEncrypt(algoId, cipherBenchMsg[i].data, msgSize,
+				&cipherBenchCt[i], &cipherBenchCtLen[i])) {
+			VTEST_LOG("Error encrypting %d byte buffer\n", msgSize);
+			return VTEST_FAIL;
+		}
+		if (clock_gettime(CLOCK_BOOTTIME, &opEnd) == -1)
+			goto fail;
+		CALCULATE_TIME_DIFF_NS(opStart, opEnd, nsTimeDiff);
+		vtestHistRecord(&cipherEncHist, nsTimeDiff);
+		nsTotal += nsTimeDiff;
+	}
+	*encMbPerSec = CIPHER_BENCH_NUM * msgSize * 1000 / (float)nsTotal;
+
+	/* Decrypt all ciphertexts */
+	vtestHistReset(&latencyHist);
+	nsTotal = 0;
+	for (i = 0; i < CIPHER_BENCH_NUM; i++) {
+		msgLen = sizeof(msg);
+		if (clock_gettime(CLOCK_BOOTTIME, &opStart) == -1)
+			goto fail;
+		if (rtCipherDecrypt(algoId, &cipherBenchCt[i],
+				cipherBenchCtLen[i], &msg, &msgLen)) {
+			VTEST_LOG("Error decrypting %d byte buffer\n", msgSize);
+			return VTEST_FAIL;
+		}
+		if (clock_gettime(CLOCK_BOOTTIME, &opEnd) == -1)
+			goto fail;
+		CALCULATE_TIME_DIFF_NS(opStart, opEnd, nsTimeDiff);
+		vtestHistRecord(&latencyHist, nsTimeDiff);
+		nsTotal += nsTimeDiff;
+
+		/* Verify buffer is correctly decrypted */
+		if ((msgLen != msgSize) || (memcmp(msg.data,
+			cipherBenchMsg[i].data, msgSize) != MEMCMP_IDENTICAL)) {
+			VTEST_LOG("Decrypted %d byte buffer does not match\n",
+								msgSize);
+			return VTEST_FAIL;
+		}
+	}
+	*decMbPerSec = CIPHER_BENCH_NUM * msgSize * 1000 / (float)nsTotal;
+	return VTEST_PASS;
+
+fail:
+	VTEST_FLAG_CONF();
+	return VTEST_FAIL;
+}
+
+/**
+ *
+ * @brief Test throughput and latency of Rt symmetric cipher
+ *
+ * This function measures v2xSe_encryptUsingRtCipher and
+ * v2xSe_decryptUsingRtCipher with an SM4 Rt key, for each algorithm of
+ * CIPHER_BENCH_ALGOS and buffer sizes doubling from one cipher block up
+ * to the largest whole number of blocks the API accepts.  Each decrypted
+ * buffer is checked against the original.  The throughput in MB/s and
+ * the latency percentiles of each call are reported.
+ *
+ */
+void test_rtCipherRate(void)
+{
+	TypeSW_t statusCode;
+	size_t maxSize;
+	size_t msgSize;
+	float encMbPerSec;
+	float decMbPerSec;
+	int status;
+	int algo;
+
+	VTEST_RETURN_CONF_IF_NO_V2X_HW();
+
+	maxSize = sizeof(TypePlainText_t) / CIPHER_BENCH_BLOCK_SIZE *
+						CIPHER_BENCH_BLOCK_SIZE;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_CN), VTEST_PASS);
+	/* Generate an Rt key to use */
+	VTEST_CHECK_RESULT(v2xSe_generateRtSymmetricKey(SLOT_ZERO,
+		V2XSE_SYMMK_SM4_128, &statusCode), V2XSE_SUCCESS);
+
+	VTEST_LOG("Algo     Bytes  Enc MB/s  Enc p50 us  Enc p99 us"
+		"  Dec MB/s  Dec p50 us  Dec p99 us\n");
+	for (algo = 0; algo < CIPHER_BENCH_NUM_ALGOS; algo++) {
+		msgSize = CIPHER_BENCH_BLOCK_SIZE;
+		while (1) {
+			status = measureRtCipher(cipherBenchAlgo[algo],
+					msgSize, &encMbPerSec, &decMbPerSec);
+			VTEST_CHECK_RESULT(status, VTEST_PASS);
+			if (status != VTEST_PASS)
+				goto stopCipherTest;
+			VTEST_LOG("%-8s %-6zu %-9.2f %-11.2f %-11.2f %-9.2f"
+				" %-11.2f %.2f\n",
+				cipherBenchName[algo], msgSize, encMbPerSec,
+				vtestHistPercentile(&cipherEncHist, 50.0f) /
+								1000.0f,
+				vtestHistPercentile(&cipherEncHist, 99.0f) /
+								1000.0f,
+				decMbPerSec,
+				vtestHistPercentile(&latencyHist, 50.0f) /
+								1000.0f,
+				vtestHistPercentile(&latencyHist, 99.0f) /
+								1000.0f);
+			if (msgSize == maxSize)
+				break;
+			msgSize = MIN(msgSize * 2, maxSize);
+		}
+	}
+
+stopCipherTest:
+	/* Delete key after use */
+	VTEST_CHECK_RESULT(v2xSe_deleteRtSymmetricKey(SLOT_ZERO, &statusCode),
+								V2XSE_SUCCESS);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+}
+
+/** State of a streaming cipher run, shared by all its workers */
+typedef struct {
+	/** Cipher algorithm, V2XSE_ALGO_xxx */
+	int algoId;
+	/** Set to decrypt the chunks, encrypt them otherwise */
+	int decrypt;
+	/** Payload, split in chunks of chunkSize bytes */
+	uint8_t *payload;
+	/** Size of the payload in bytes */
+	size_t payloadSize;
+	/** Size of the chunks in bytes, the last one can be shorter */
+	size_t chunkSize;
+	/** Ciphertext of each chunk */
+	TypeVCTData_t *ct;
+	/** Ciphertext length of each chunk */
+	TypeLen_t *ctLen;
+	/** Number of chunks */
+	long numChunks;
+	/** Index of next chunk to process */
+	long nextChunk;
+	/** Set when a call failed */
+	int failed;
+} TypeCipherStream_t;
+
+/** Threads of the streaming cipher benchmark */
+static pthread_t cipherStreamThreads[CIPHER_STREAM_MAX_THREADS];
+/** Streaming cipher run in progress */
+static TypeCipherStream_t cipherStream;
+
+/**
+ * @brief   Worker thread of the streaming cipher benchmark
+ *
+ * Takes the next unprocessed chunk of the payload and encrypts or
+ * decrypts it, until all chunks are done.  Decrypted chunks are written
+ * back to the payload.  The latency of each call is recorded in
+ * latencyHist.
+ *
+ * @param arg state of the streaming run
+ *
+ * @return NULL
+ *
+ */
+static void *cipherStreamWorker(void *arg)
+{
+	TypeCipherStream_t *stream = arg;
+	TypePlainText_t msg;
+	TypeLen_t msgLen;
+	struct timespec callStart;
+	struct timespec callEnd;
+	long nsLatency;
+	long chunk;
+	size_t offset;
+	size_t size;
+	int32_t ret;
+
+	while ((chunk = __atomic_fetch_add(&stream->nextChunk, 1,
+				__ATOMIC_RELAXED)) < stream->numChunks) {
+		offset = chunk * stream->chunkSize;
+		size = MIN(stream->chunkSize, stream->payloadSize - offset);
+		msgLen = sizeof(msg);
+		if (clock_gettime(CLOCK_BOOTTIME, &callStart) == -1)
+			goto fail;
+		if (stream->decrypt) {
+			ret = rtCipherDecrypt(stream->algoId,
+				&stream->ct[chunk], stream->ctLen[chunk],
+				&msg, &msgLen);
+		} else {
+			stream->ctLen[chunk] = sizeof(TypeVCTData_t);
+			ret = rtCipherEncrypt(stream->algoId,
+				stream->payload + offset, size,
+				&stream->ct[chunk], &stream->ctLen[chunk]);
+		}
+		if (clock_gettime(CLOCK_BOOTTIME, &callEnd) == -1)
+			goto fail;
+		if (ret || (stream->decrypt && (msgLen != size))) {
+			VTEST_LOG("Error processing chunk %ld\n", chunk);
+			__atomic_store_n(&stream->failed, 1, __ATOMIC_RELAXED);
+			break;
+		}
+		if (stream->decrypt)
+			memcpy(stream->payload + offset, msg.data, size);
+		CALCULATE_TIME_DIFF_NS(callStart, callEnd, nsLatency);
+		vtestHistRecord(&latencyHist, nsLatency);
+	}
+	return NULL;
+
+fail:
+	VTEST_FLAG_CONF();
+	__atomic_store_n(&stream->failed, 1, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+/**
+ * @brief   Encrypt or decrypt the whole stream payload from several threads
+ *
+ * The latency of each call is recorded in latencyHist.
+ *
+ * @param decrypt set to decrypt the chunks, encrypt them otherwise
+ * @param numThreads number of worker threads
+ *
+ * @return aggregate throughput in MB/s, or 0 on failure
+ *
+ */
+static float runCipherStream(int decrypt, int numThreads)
+{
+	long nsTimeDiff;
+	int numStarted;
+	int i;
+
+	cipherStream.decrypt = decrypt;
+	cipherStream.nextChunk = 0;
+	cipherStream.failed = 0;
+	vtestHistReset(&latencyHist);
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	for (numStarted = 0; numStarted < numThreads; numStarted++) {
+		if (pthread_create(&cipherStreamThreads[numStarted], NULL,
+				cipherStreamWorker, &cipherStream)) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+	}
+	for (i = 0; i < numStarted; i++)
+		pthread_join(cipherStreamThreads[i], NULL);
+	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	if ((numStarted < numThreads) ||
+		__atomic_load_n(&cipherStream.failed, __ATOMIC_RELAXED))
+		return 0;
+
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	return cipherStream.payloadSize * 1000 / (float)nsTimeDiff;
+}
+
+/**
+ *
+ * @brief Test bulk throughput of Rt symmetric cipher in streaming mode
+ *
+ * This function splits a payload of CIPHER_STREAM_BYTES random bytes in
+ * chunks of the largest whole number of cipher blocks the API accepts,
+ * and encrypts then decrypts all chunks from a pool of 1, 2...
+ * CIPHER_STREAM_MAX_THREADS worker threads, for each algorithm of
+ * CIPHER_BENCH_ALGOS.  The decrypted payload is checked against the
+ * original.  The aggregate throughput and the latency of each call are
+ * reported.
+ *
+ */
+void test_rtCipherStream(void)
+{
+	TypeSW_t statusCode;
+	uint8_t *original;
+	float encMbPerSec;
+	float decMbPerSec;
+	int numThreads;
+	int algo;
+
+	VTEST_RETURN_CONF_IF_NO_V2X_HW();
+
+	cipherStream.payloadSize = CIPHER_STREAM_BYTES;
+	cipherStream.chunkSize = sizeof(TypePlainText_t) /
+			CIPHER_BENCH_BLOCK_SIZE * CIPHER_BENCH_BLOCK_SIZE;
+	cipherStream.numChunks = (cipherStream.payloadSize +
+		cipherStream.chunkSize - 1) / cipherStream.chunkSize;
+	original = malloc(cipherStream.payloadSize);
+	cipherStream.payload = malloc(cipherStream.payloadSize);
+	cipherStream.ct = malloc(cipherStream.numChunks *
+						sizeof(TypeVCTData_t));
+	cipherStream.ctLen = malloc(cipherStream.numChunks *
+						sizeof(TypeLen_t));
+	VTEST_CHECK_RESULT((!original || !cipherStream.payload ||
+			!cipherStream.ct || !cipherStream.ctLen), 0);
+	if (!original || !cipherStream.payload || !cipherStream.ct ||
+							!cipherStream.ctLen)
+		goto freeStreamData;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_CN), VTEST_PASS);
+	/* Random payload, from SE random number generator */
+	VTEST_CHECK_RESULT(fillRandomData(original, cipherStream.payloadSize),
+								VTEST_PASS);
+	/* Generate an Rt key to use */
+	VTEST_CHECK_RESULT(v2xSe_generateRtSymmetricKey(SLOT_ZERO,
+		V2XSE_SYMMK_SM4_128, &statusCode), V2XSE_SUCCESS);
+
+	VTEST_LOG("Algo     Chunk  Threads  Enc MB/s  Enc p99 us"
+		"  Dec MB/s  Dec p99 us\n");
+	for (algo = 0; algo < CIPHER_BENCH_NUM_ALGOS; algo++) {
+		cipherStream.algoId = cipherBenchAlgo[algo];
+		for (numThreads = 1; numThreads <= CIPHER_STREAM_MAX_THREADS;
+							numThreads *= 2) {
+			memcpy(cipherStream.payload, original,
+						cipherStream.payloadSize);
+			encMbPerSec = runCipherStream(0, numThreads);
+			VTEST_LOG("%-8s %-6zu %-8d %-9.2f %-11.2f",
+				cipherBenchName[algo], cipherStream.chunkSize,
+				numThreads, encMbPerSec,
+				vtestHistPercentile(&latencyHist, 99.0f) /
+								1000.0f);
+			memset(cipherStream.payload, 0,
+						cipherStream.payloadSize);
+			decMbPerSec = runCipherStream(1, numThreads);
+			VTEST_LOG(" %-9.2f %.2f\n", decMbPerSec,
+				vtestHistPercentile(&latencyHist, 99.0f) /
+								1000.0f);
+			VTEST_CHECK_RESULT((!encMbPerSec || !decMbPerSec), 0);
+			if (!encMbPerSec || !decMbPerSec)
+				goto stopStreamTest;
+
+			/* Verify payload is correctly decrypted */
+			VTEST_CHECK_RESULT(memcmp(cipherStream.payload,
+				original, cipherStream.payloadSize),
+							MEMCMP_IDENTICAL);
+		}
+	}
+
+stopStreamTest:
+	/* Delete key after use */
+	VTEST_CHECK_RESULT(v2xSe_deleteRtSymmetricKey(SLOT_ZERO, &statusCode),
+								V2XSE_SUCCESS);
+
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
+
+freeStreamData:
+	free(original);
+	free(cipherStream.payload);
+	free(cipherStream.ct);
+	free(cipherStream.ctLen);
+}
+
+/** State of one thread of the random number benchmark */
+typedef struct {
+	/** Thread handle */
+	pthread_t thread;
+	/** Number of random bytes requested per call */
+	TypeLen_t size;
+	/** Number of calls to make */
+	long numCalls;
+	/** Set when a call failed */
+	int failed;
+} TypeRngWorker_t;
+
+/** Threads of the random number benchmark */
+static TypeRngWorker_t rngWorkers[RNG_BENCH_MAX_THREADS];
+
+/**
+ * @brief   Thread of the random number benchmark
+ *
+ * Calls v2xSe_getRandomNumber numCalls times, recording the latency of
+ * each successful call in latencyHist.  Stops at the first failed call.
+ *
+ * @param arg state of the thread
+ *
+ * @return NULL
+ *
+ */
+static void *rngBenchWorker(void *arg)
+{
+	TypeRngWorker_t *worker = arg;
+	TypeSW_t statusCode;
+	TypeRandomNumber_t rnd;
+	struct timespec callStart;
+	struct timespec callEnd;
+	long nsLatency;
+	long i;
+	int32_t ret;
+
+	for (i = 0; i < worker->numCalls; i++) {
+		if (clock_gettime(CLOCK_BOOTTIME, &callStart) == -1) {
+			VTEST_FLAG_CONF();
+			worker->failed = 1;
+			break;
+		}
+		ret = v2xSe_getRandomNumber(worker->size, &statusCode, &rnd);
+		if (clock_gettime(CLOCK_BOOTTIME, &callEnd) == -1) {
+			VTEST_FLAG_CONF();
+			worker->failed = 1;
+			break;
+		}
+		VTEST_CHECK_RESULT(ret, V2XSE_SUCCESS);
+		if (ret != V2XSE_SUCCESS) {
+			worker->failed = 1;
+			break;
+		}
+		CALCULATE_TIME_DIFF_NS(callStart, callEnd, nsLatency);
+		vtestHistRecord(&latencyHist, nsLatency);
+	}
+	return NULL;
+}
+
+/**
+ * @brief   Measure random number throughput from several threads
+ *
+ * RNG_BENCH_CALLS calls are shared between the threads.  The latency of
+ * each successful call is recorded in latencyHist.
+ *
+ * @param size number of random bytes requested per call
+ * @param numThreads number of threads
+ *
+ * @return aggregate throughput in bytes/sec, or 0 if any call failed
+ *
+ */
+static long runRngBench(TypeLen_t size, int numThreads)
+{
+	long nsTimeDiff;
+	int numStarted;
+	int failed = 0;
+	int i;
+
+	vtestHistReset(&latencyHist);
+	if (clock_gettime(CLOCK_BOOTTIME, &startTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	for (numStarted = 0; numStarted < numThreads; numStarted++) {
+		rngWorkers[numStarted].size = size;
+		rngWorkers[numStarted].numCalls = RNG_BENCH_CALLS / numThreads;
+		rngWorkers[numStarted].failed = 0;
+		if (pthread_create(&rngWorkers[numStarted].thread, NULL,
+				rngBenchWorker, &rngWorkers[numStarted])) {
+			VTEST_FLAG_CONF();
+			break;
+		}
+	}
+	for (i = 0; i < numStarted; i++) {
+		pthread_join(rngWorkers[i].thread, NULL);
+		failed |= rngWorkers[i].failed;
+	}
+	if (clock_gettime(CLOCK_BOOTTIME, &endTime) == -1) {
+		VTEST_FLAG_CONF();
+		return 0;
+	}
+	if ((numStarted < numThreads) || failed)
+		return 0;
+
+	CALCULATE_TIME_DIFF_NS(startTime, endTime, nsTimeDiff);
+	return latencyHist.count * size * 1000000000l / nsTimeDiff;
+}
+
+/**
+ *
+ * @brief Test throughput of the SE random number generator
+ *
+ * This function measures v2xSe_getRandomNumber for request sizes
+ * doubling from 1 byte up to V2XSE_MAX_RND_NUM_SIZE, from 1, 2...
+ * RNG_BENCH_MAX_THREADS threads.  The aggregate throughput in bytes/sec
+ * and calls/sec, and the latency of each call are reported.
+ *
+ */
+void test_rngRate(void)
+{
+	long bytesPerSec;
+	size_t size;
+	int numThreads;
+
+	/* Move to ACTIVATED state, normal operating mode */
+	VTEST_CHECK_RESULT(setupActivatedNormalState(e_EU), VTEST_PASS);
+
+	VTEST_LOG("Size (B)  Threads  Bytes/sec  Calls/sec  p50 us    p99 us"
+		"    max us\n");
+	size = 1;
+	while (1) {
+		for (numThreads = 1; numThreads <= RNG_BENCH_MAX_THREADS;
+							numThreads *= 2) {
+			bytesPerSec = runRngBench(size, numThreads);
+			if (!bytesPerSec)
+				goto stopRngTest;
+			VTEST_LOG("%-9zu %-8d %-10ld %-10ld %-9.2f %-9.2f"
+				" %.2f\n", size, numThreads, bytesPerSec,
+				bytesPerSec / size,
+				vtestHistPercentile(&latencyHist, 50.0f) /
+								1000.0f,
+				vtestHistPercentile(&latencyHist, 99.0f) /
+								1000.0f,
+				latencyHist.max / 1000.0f);
+		}
+		if (size == V2XSE_MAX_RND_NUM_SIZE)
+			break;
+		size = MIN(size * 2, V2XSE_MAX_RND_NUM_SIZE);
+	}
+
+stopRngTest:
+/* Go back to init to leave system in known state after test */
+	VTEST_CHECK_RESULT(setupInitState(), VTEST_PASS);
 }
@@ -51,7 +51,7 @@
 /** Result of memcmp when values match */
 #define MEMCMP_IDENTICAL      0
 
-static volatile int count_async = ASYNC_COUNT_RESET;
+static vtestAsync_t count_async = VTEST_ASYNC_INITIALIZER;
 
 /** Data to calculate signature on for tests */
 TypeHash_t testHash = {
@@ -117,8 +117,8 @@ static void signatureVerificationCallback(void *sequence_number,
 	int ret,
 	ecdsa_verification_result_t verification_result)
 {
-	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 	VTEST_CHECK_RESULT(verification_result, ECDSA_VERIFICATION_SUCCESS);
+	VTEST_CHECK_RESULT_ASYNC_DEC(ret, ECDSA_NO_ERROR, count_async);
 }
 
 #ifndef ECC_PATTERNS_BIG_ENDIAN
@@ -42,6 +42,7 @@
  */
 
 #include <stdarg.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -52,6 +53,8 @@
 currentTestStatus_t currentTestStatus;
 /** Combined status of all tests run */
 overallTestStatus_t overallTestStatus = {0,0,0,0,0,0,0};
+/** Lock for subtest counters, updated from test and callback threads */
+static pthread_mutex_t checkResultLock = PTHREAD_MUTEX_INITIALIZER;
 
 extern testEntry_t allTests[];
 int getNumTests(void);
@@ -116,7 +119,7 @@ void outputLog(const char *const fileName, const int lineNumber,
  * @brief Utility function to check the result of a function call
  *
  * This function checks the result of a function call and updates the
- * subtest counter appropriately
+ * subtest counter appropriately.  It can be called from several threads.
  *
  * @param fileName name of source file this function is called from
  * @param lineNumber source line number this function is called from
@@ -127,12 +130,14 @@ void outputLog(const char *const fileName, const int lineNumber,
 void checkResult(const char *const fileName,
 		const int lineNumber, int actual, int expected)
 {
+	pthread_mutex_lock(&checkResultLock);
 	currentTestStatus.currentSubTestsRun++;
 	if (actual != expected) {
 		currentTestStatus.currentSubTestsFail++;
 		printf("ERROR: %s:%d expected %d, got %d\n", fileName,
 						lineNumber, expected, actual);
 	}
+	pthread_mutex_unlock(&checkResultLock);
 }
 
 /**
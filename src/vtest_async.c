@@ -0,0 +1,264 @@
+/*
+ * Copyright 2020 NXP
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON  ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS  SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ *
+ * @file vtest_async.c
+ *
+ * @brief Completion tracking for V2X test asynchronous API calls
+ *
+ */
+
+#include <errno.h>
+#include <string.h>
+#include "vtest_async.h"
+
+/**
+ *
+ * @brief Register one more outstanding async API call
+ *
+ * @param async completion counter to update
+ *
+ */
+void vtestAsyncInc(vtestAsync_t *async)
+{
+	pthread_mutex_lock(&async->lock);
+	async->count++;
+	pthread_mutex_unlock(&async->lock);
+}
+
+/**
+ *
+ * @brief Register the return of an async API call
+ *
+ * Any test waiting on the counter is woken up when the last outstanding
+ * call has returned.
+ *
+ * @param async completion counter to update
+ *
+ */
+void vtestAsyncDec(vtestAsync_t *async)
+{
+	pthread_mutex_lock(&async->lock);
+	if (--async->count <= ASYNC_COUNT_RESET)
+		pthread_cond_broadcast(&async->done);
+	pthread_mutex_unlock(&async->lock);
+}
+
+/**
+ *
+ * @brief Wait for all outstanding async API calls to return
+ *
+ * Returns as soon as the last outstanding call has returned, or when the
+ * timeout expires, whichever comes first.
+ *
+ * @param async completion counter to wait on
+ * @param timeoutUs maximum time to wait, in us
+ *
+ * @return number of calls still outstanding, ASYNC_COUNT_RESET if none
+ *
+ */
+int vtestAsyncWait(vtestAsync_t *async, long timeoutUs)
+{
+	struct timespec deadline;
+	int count;
+
+	/* Default condvar clock is CLOCK_REALTIME */
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += timeoutUs / 1000000;
+	deadline.tv_nsec += (timeoutUs % 1000000) * 1000;
+	if (deadline.tv_nsec >= 1000000000) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000;
+	}
+
+	pthread_mutex_lock(&async->lock);
+	while (async->count > ASYNC_COUNT_RESET) {
+		if (pthread_cond_timedwait(&async->done, &async->lock,
+						&deadline) == ETIMEDOUT)
+			break;
+	}
+	count = async->count;
+	pthread_mutex_unlock(&async->lock);
+
+	return count;
+}
+
+/**
+ *
+ * @brief Reset the count and request slots of outstanding async API calls
+ *
+ * Slots still pending belong to calls already reported as missing by the
+ * wait, they are simply released here.
+ *
+ * @param async completion counter to reset
+ *
+ * @return number of duplicated or unknown callbacks received since last reset
+ *
+ */
+int vtestAsyncReset(vtestAsync_t *async)
+{
+	int numBadCallbacks;
+	int i;
+
+	pthread_mutex_lock(&async->lock);
+	async->count = ASYNC_COUNT_RESET;
+	for (i = 0; i < ASYNC_REQ_SLOTS; i++)
+		async->slots[i].state = ASYNC_REQ_FREE;
+	numBadCallbacks = async->numBadCallbacks;
+	async->numBadCallbacks = 0;
+	pthread_mutex_unlock(&async->lock);
+
+	if (numBadCallbacks)
+		printf("%d duplicated or unknown responses!\n",
+							numBadCallbacks);
+	return numBadCallbacks;
+}
+
+/**
+ *
+ * @brief Reserve a request slot for an async API call
+ *
+ * The slot records the issue time, the operation type and the expected
+ * result of the call.  The returned pointer must be passed as the
+ * sequence_number of the call, so the callback can find its slot again.
+ * Slots are handed out round robin, so a freed slot is reused as late as
+ * possible and a late duplicate callback is still caught.
+ *
+ * @param async completion counter holding the request slots
+ * @param opType operation type, one of ASYNC_OP_*
+ * @param expResult expected result of the operation
+ *
+ * @return pointer to the request slot, NULL if all slots are in use
+ *
+ */
+void *vtestAsyncReqIssue(vtestAsync_t *async, int opType, int expResult)
+{
+	return vtestAsyncReqIssueAt(async, opType, expResult, NULL);
+}
+
+/**
+ *
+ * @brief Reserve a request slot for an async API call scheduled at sendTime
+ *
+ * Same as vtestAsyncReqIssue, except that the latency of the call will be
+ * measured from sendTime rather than from the time the slot is reserved.
+ * This is used by open loop tests, so that any delay in sending the call
+ * is counted in its latency.
+ *
+ * @param async completion counter holding the request slots
+ * @param opType operation type, one of ASYNC_OP_*
+ * @param expResult expected result of the operation
+ * @param sendTime scheduled send time (CLOCK_BOOTTIME), NULL for now
+ *
+ * @return pointer to the request slot, NULL if all slots are in use
+ *
+ */
+void *vtestAsyncReqIssueAt(vtestAsync_t *async, int opType, int expResult,
+					const struct timespec *sendTime)
+{
+	vtestAsyncReq_t *req = NULL;
+	int i;
+
+	pthread_mutex_lock(&async->lock);
+	for (i = 0; i < ASYNC_REQ_SLOTS; i++) {
+		if (async->slots[async->nextSlot].state == ASYNC_REQ_FREE) {
+			req = &async->slots[async->nextSlot];
+			req->state = ASYNC_REQ_PENDING;
+		}
+		async->nextSlot = (async->nextSlot + 1) % ASYNC_REQ_SLOTS;
+		if (req)
+			break;
+	}
+	pthread_mutex_unlock(&async->lock);
+
+	if (!req) {
+		printf("No free async request slot!\n");
+		return NULL;
+	}
+	req->opType = opType;
+	req->expResult = expResult;
+	req->nsLatency = 0;
+	req->owner = 0;
+	if (sendTime)
+		req->issueTime = *sendTime;
+	else if (clock_gettime(CLOCK_BOOTTIME, &req->issueTime) == -1)
+		flagConf();
+
+	return req;
+}
+
+/**
+ *
+ * @brief Release the request slot of an async API call from its callback
+ *
+ * The slot content, including the latency of the call, is copied to req
+ * before the slot is released.  A callback with a sequence_number that is
+ * not a pending slot is a duplicate or unknown response: it is counted and
+ * reported by the next vtestAsyncReset.
+ *
+ * @param async completion counter holding the request slots
+ * @param sequence_number sequence_number received by the callback
+ * @param req location to copy the slot content to
+ *
+ * @return VTEST_PASS if the slot was pending, VTEST_FAIL otherwise
+ *
+ */
+int vtestAsyncReqComplete(vtestAsync_t *async, void *sequence_number,
+						vtestAsyncReq_t *req)
+{
+	vtestAsyncReq_t *slot = sequence_number;
+	struct timespec now;
+	int ret = VTEST_FAIL;
+
+	if (clock_gettime(CLOCK_BOOTTIME, &now) == -1)
+		flagConf();
+
+	pthread_mutex_lock(&async->lock);
+	if ((slot >= async->slots) && (slot < async->slots + ASYNC_REQ_SLOTS)
+				&& (slot->state == ASYNC_REQ_PENDING)) {
+		slot->nsLatency = (now.tv_sec - slot->issueTime.tv_sec) *
+								1000000000;
+		slot->nsLatency += now.tv_nsec - slot->issueTime.tv_nsec;
+		slot->state = ASYNC_REQ_FREE;
+		*req = *slot;
+		ret = VTEST_PASS;
+	} else {
+		async->numBadCallbacks++;
+		memset(req, 0, sizeof(*req));
+	}
+	pthread_mutex_unlock(&async->lock);
+
+	return ret;
+}
@@ -0,0 +1,202 @@
+
+/*
+ * Copyright 2019 NXP
+ */
+
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON  ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS  SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ *
+ * @file vtest_hist.c
+ *
+ * @brief Latency histograms for V2X test performance measurements
+ *
+ * Values are counted in buckets with a fixed relative precision: values
+ * below HIST_SUB_BUCKETS have a bucket each, above that each power of 2 is
+ * split in HIST_SUB_BUCKETS buckets.  Memory use is fixed, and recording a
+ * value is a few atomic operations, so callbacks can record directly.
+ *
+ */
+
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include "vtest.h"
+#include "vtest_hist.h"
+
+/**
+ *
+ * @brief Get the bucket index of a value
+ *
+ * @param value value to look up, must not be negative
+ *
+ * @return bucket index
+ *
+ */
+static int bucketIndex(long value)
+{
+	int shift;
+
+	if (value < HIST_SUB_BUCKETS)
+		return value;
+	shift = (63 - __builtin_clzl(value)) - HIST_SUB_BUCKET_BITS;
+	return ((shift + 1) << HIST_SUB_BUCKET_BITS) +
+				(int)(value >> shift) - HIST_SUB_BUCKETS;
+}
+
+/**
+ *
+ * @brief Get the highest value counted in a bucket
+ *
+ * @param index bucket index
+ *
+ * @return highest value of the bucket
+ *
+ */
+static long bucketHighestValue(int index)
+{
+	int shift;
+	long base;
+
+	if (index < HIST_SUB_BUCKETS)
+		return index;
+	shift = (index >> HIST_SUB_BUCKET_BITS) - 1;
+	base = (index & (HIST_SUB_BUCKETS - 1)) + HIST_SUB_BUCKETS;
+	return ((base + 1) << shift) - 1;
+}
+
+/**
+ *
+ * @brief Clear all values from a histogram
+ *
+ * Must not be called while other threads are recording.
+ *
+ * @param hist histogram to clear
+ *
+ */
+void vtestHistReset(vtestHist_t *hist)
+{
+	memset(hist->buckets, 0, sizeof(hist->buckets));
+	hist->count = 0;
+	hist->min = LONG_MAX;
+	hist->max = 0;
+}
+
+/**
+ *
+ * @brief Record a value in a histogram
+ *
+ * Can be called from several threads in parallel.  Negative values are
+ * recorded as 0.
+ *
+ * @param hist histogram to update
+ * @param value value to record
+ *
+ */
+void vtestHistRecord(vtestHist_t *hist, long value)
+{
+	long prev;
+
+	if (value < 0)
+		value = 0;
+	__atomic_fetch_add(&hist->buckets[bucketIndex(value)], 1,
+							__ATOMIC_RELAXED);
+	__atomic_fetch_add(&hist->count, 1, __ATOMIC_RELAXED);
+
+	prev = __atomic_load_n(&hist->max, __ATOMIC_RELAXED);
+	while ((value > prev) && !__atomic_compare_exchange_n(&hist->max,
+			&prev, value, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+	prev = __atomic_load_n(&hist->min, __ATOMIC_RELAXED);
+	while ((value < prev) && !__atomic_compare_exchange_n(&hist->min,
+			&prev, value, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+}
+
+/**
+ *
+ * @brief Get a percentile of the values recorded in a histogram
+ *
+ * The result is the highest value of the bucket holding the percentile,
+ * capped to the highest value recorded, so never under-estimates.
+ *
+ * @param hist histogram to read
+ * @param percentile percentile to get, 0.0 to 100.0
+ *
+ * @return value at percentile, 0 if histogram is empty
+ *
+ */
+long vtestHistPercentile(vtestHist_t *hist, float percentile)
+{
+	long target;
+	long seen = 0;
+	long value;
+	int i;
+
+	if (!hist->count)
+		return 0;
+	target = (long)ceil(hist->count * (double)percentile / 100);
+	if (target < 1)
+		target = 1;
+
+	for (i = 0; i < HIST_NUM_BUCKETS; i++) {
+		seen += hist->buckets[i];
+		if (seen >= target)
+			break;
+	}
+	value = bucketHighestValue(i);
+	return (value > hist->max) ? hist->max : value;
+}
+
+/**
+ *
+ * @brief Log latency percentiles of a histogram
+ *
+ * @param hist histogram of latencies in ns
+ * @param name name of measured operation for the log message
+ *
+ */
+void vtestHistLog(vtestHist_t *hist, char *name)
+{
+	if (!hist->count) {
+		VTEST_LOG("%s latency: no values recorded\n", name);
+		return;
+	}
+	VTEST_LOG("%s latency (%ld values): %.2f ms min, %.2f ms p50,"
+			" %.2f ms p90, %.2f ms p99, %.2f ms p99.9,"
+			" %.2f ms max\n", name, hist->count,
+			hist->min / (float)1000000,
+			vtestHistPercentile(hist, 50.0f) / (float)1000000,
+			vtestHistPercentile(hist, 90.0f) / (float)1000000,
+			vtestHistPercentile(hist, 99.0f) / (float)1000000,
+			vtestHistPercentile(hist, 99.9f) / (float)1000000,
+			hist->max / (float)1000000);
+}